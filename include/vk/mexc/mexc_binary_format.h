@@ -0,0 +1,493 @@
+/**
+MEXC Binary Format
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_BINARY_FORMAT_H
+#define INCLUDE_VK_MEXC_BINARY_FORMAT_H
+
+#include "mexc_models.h"
+#include "mexc_event_models.h"
+#include "mexc_json_fields.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Versioned fixed-layout binary encoding of the models, e.g. to pass them to another process or to cache them.
+ *
+ * Layout (little-endian):
+ *   header  magic "MXB\0" (u32), minor version (u8), major version (u8), type (u16), record count (u32),
+ *           record size (u32)
+ *   records count * record size bytes, the fields of BinaryLayout<T>::Fields in their order without padding
+ *   heap    bytes of the strings and string lists referenced from the records
+ *
+ * Numbers, booleans and enums are stored directly, prices and quantities as int64 mantissa + int32 exponent, fixed
+ * decimals as their raw int64 value, strings as u32 offset + u32
+ * length into the buffer and string lists as u32 offset + u32 count of such string references. Readers use the
+ * record size from the header as the stride. Appending fields to a layout bumps the minor version only, a reader
+ * accepts buffers of any minor version of its major one and skips the fields it does not know. A buffer of an older
+ * minor version is accepted as long as its records contain all fields of the reader's layout. Removing, reordering
+ * or changing a field bumps the major version, readers reject buffers of another major version.
+ */
+namespace vk::mexc {
+static_assert(std::endian::native == std::endian::little, "Binary format is implemented for little-endian hosts only");
+
+constexpr std::uint32_t BINARY_MAGIC = 0x0042584D; // "MXB\0"
+/// 2: ContractDetail::priceUnit is double, 3: prices and quantities are stored as mantissa and exponent
+constexpr std::uint8_t BINARY_VERSION_MAJOR = 3;
+/// Bumped when fields are appended to a layout, reset to 0 with a new major version
+constexpr std::uint8_t BINARY_VERSION_MINOR = 0;
+constexpr std::size_t BINARY_HEADER_SIZE = 16;
+
+enum class BinaryType : std::uint16_t {
+    SpotCandle = 1,
+    FuturesCandle = 2,
+    FuturesTicker = 3,
+    FundingRate = 4,
+    HistoricalFundingRate = 5,
+    ContractDetail = 6,
+    EventTicker = 7,
+    EventCandlestick = 8
+};
+
+namespace detail {
+template<auto Member>
+using BinaryMemberType = typename MemberPointerTraits<decltype(Member)>::Member;
+
+template<typename M>
+constexpr bool IS_BINARY_STRING = std::is_same_v<M, std::string>;
+
+template<typename M>
+constexpr bool IS_BINARY_STRING_LIST = std::is_same_v<M, std::vector<std::string>>;
+
+template<typename M>
+constexpr std::size_t binarySize() {
+    if constexpr (std::is_same_v<M, Decimal>) {
+        return 12;
+    } else if constexpr (IS_BINARY_STRING<M> || IS_BINARY_STRING_LIST<M> || IsDecimal<M>::value) {
+        return 8;
+    } else if constexpr (std::is_same_v<M, bool>) {
+        return 1;
+    } else {
+        static_assert(std::is_arithmetic_v<M> || std::is_enum_v<M>, "Unsupported binary field type");
+        return sizeof(M);
+    }
+}
+
+template<auto A, auto B>
+constexpr bool isSameMember() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+        return A == B;
+    } else {
+        return false;
+    }
+}
+
+template<typename T>
+void storeScalar(std::string &buffer, const std::size_t pos, const T value) {
+    std::memcpy(buffer.data() + pos, &value, sizeof(T));
+}
+
+template<typename T>
+T loadScalar(const std::string_view buffer, const std::size_t pos) {
+    T value;
+    std::memcpy(&value, buffer.data() + pos, sizeof(T));
+    return value;
+}
+
+inline void checkRange(const std::string_view buffer, const std::uint64_t offset, const std::uint64_t length) {
+    if (offset > buffer.size() || length > buffer.size() - offset) {
+        throw std::runtime_error("Binary reference out of range");
+    }
+}
+
+inline std::uint32_t heapOffset(const std::string &buffer) {
+    if (buffer.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Binary buffer is too large");
+    }
+
+    return static_cast<std::uint32_t>(buffer.size());
+}
+
+inline std::string_view loadString(const std::string_view buffer, const std::size_t pos) {
+    const auto offset = loadScalar<std::uint32_t>(buffer, pos);
+    const auto length = loadScalar<std::uint32_t>(buffer, pos + 4);
+    checkRange(buffer, offset, length);
+    return buffer.substr(offset, length);
+}
+}
+
+/**
+ * View of a string list field, the strings point into the binary buffer
+ */
+class BinaryStringList {
+    std::string_view m_buffer;
+    std::uint32_t m_offset{};
+    std::uint32_t m_count{};
+
+public:
+    BinaryStringList(const std::string_view buffer, const std::uint32_t offset, const std::uint32_t count)
+        : m_buffer(buffer), m_offset(offset), m_count(count) {
+        detail::checkRange(buffer, offset, static_cast<std::uint64_t>(count) * 8);
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return m_count;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] std::string_view operator[](const std::size_t index) const {
+        if (index >= m_count) {
+            throw std::out_of_range("Binary string list index out of range");
+        }
+
+        return detail::loadString(m_buffer, m_offset + index * 8);
+    }
+};
+
+/**
+ * Ordered list of the encoded data members of a model
+ */
+template<auto... Members>
+struct BinaryFields {
+    static constexpr std::size_t RECORD_SIZE = (detail::binarySize<detail::BinaryMemberType<Members>>() + ...);
+
+    template<auto Member>
+    static constexpr bool contains() {
+        return (detail::isSameMember<Member, Members>() || ...);
+    }
+
+    template<auto Member>
+    static constexpr std::size_t offsetOf() {
+        static_assert(contains<Member>(), "Member is not a field of the binary layout");
+        std::size_t offset = 0;
+        bool found = false;
+        ((found = found || detail::isSameMember<Member, Members>(),
+          offset += found ? 0 : detail::binarySize<detail::BinaryMemberType<Members>>()), ...);
+        return offset;
+    }
+
+    /**
+     * Call visitor.template operator()<Member>(offset) for each field
+     */
+    template<typename Visitor>
+    static void forEach(Visitor &&visitor) {
+        std::size_t offset = 0;
+        ((visitor.template operator()<Members>(offset),
+          offset += detail::binarySize<detail::BinaryMemberType<Members>>()), ...);
+    }
+};
+
+template<typename T>
+struct BinaryLayout;
+
+template<>
+struct BinaryLayout<spot::Candle> {
+    static constexpr auto TYPE = BinaryType::SpotCandle;
+    using Fields = BinaryFields<&spot::Candle::openTime, &spot::Candle::closeTime, &spot::Candle::open,
+                                &spot::Candle::high, &spot::Candle::low, &spot::Candle::close, &spot::Candle::volume,
+                                &spot::Candle::quoteAssetVolume>;
+};
+
+template<>
+struct BinaryLayout<futures::Candle> {
+    static constexpr auto TYPE = BinaryType::FuturesCandle;
+    using Fields = BinaryFields<&futures::Candle::openTime, &futures::Candle::open, &futures::Candle::high,
+                                &futures::Candle::low, &futures::Candle::close, &futures::Candle::volume,
+                                &futures::Candle::amount>;
+};
+
+template<>
+struct BinaryLayout<futures::Ticker> {
+    static constexpr auto TYPE = BinaryType::FuturesTicker;
+    using Fields = BinaryFields<&futures::Ticker::symbol, &futures::Ticker::lastPrice, &futures::Ticker::bid1,
+                                &futures::Ticker::ask1, &futures::Ticker::volume24, &futures::Ticker::amount24,
+                                &futures::Ticker::holdVol, &futures::Ticker::timestamp>;
+};
+
+template<>
+struct BinaryLayout<futures::FundingRate> {
+    static constexpr auto TYPE = BinaryType::FundingRate;
+    using Fields = BinaryFields<&futures::FundingRate::symbol, &futures::FundingRate::fundingRate,
+                                &futures::FundingRate::maxFundingRate, &futures::FundingRate::minFundingRate,
+                                &futures::FundingRate::collectCycle, &futures::FundingRate::nextSettleTime,
+                                &futures::FundingRate::timestamp>;
+};
+
+template<>
+struct BinaryLayout<futures::HistoricalFundingRate> {
+    static constexpr auto TYPE = BinaryType::HistoricalFundingRate;
+    using Fields = BinaryFields<&futures::HistoricalFundingRate::symbol, &futures::HistoricalFundingRate::fundingRate,
+                                &futures::HistoricalFundingRate::settleTime>;
+};
+
+template<>
+struct BinaryLayout<futures::ContractDetail> {
+    static constexpr auto TYPE = BinaryType::ContractDetail;
+    using Fields = BinaryFields<&futures::ContractDetail::symbol, &futures::ContractDetail::displayNameEn,
+                                &futures::ContractDetail::baseCoin, &futures::ContractDetail::quoteCoin,
+                                &futures::ContractDetail::settleCoin, &futures::ContractDetail::state,
+                                &futures::ContractDetail::apiAllowed, &futures::ContractDetail::automaticDelivery,
+                                &futures::ContractDetail::contractSize, &futures::ContractDetail::minVol,
+                                &futures::ContractDetail::maxVol, &futures::ContractDetail::volUnit,
+                                &futures::ContractDetail::priceUnit, &futures::ContractDetail::pricePrecision,
+                                &futures::ContractDetail::volPrecision, &futures::ContractDetail::conceptPlate>;
+};
+
+/// symbolId is local to the process, it is not encoded and it is interned again when decoding
+template<>
+struct BinaryLayout<futures::EventTicker> {
+    static constexpr auto TYPE = BinaryType::EventTicker;
+    using Fields = BinaryFields<&futures::EventTicker::symbol, &futures::EventTicker::bid1,
+                                &futures::EventTicker::ask1, &futures::EventTicker::volume24,
+                                &futures::EventTicker::holdVol, &futures::EventTicker::lower24Price,
+                                &futures::EventTicker::high24Price, &futures::EventTicker::riseFallRate,
+                                &futures::EventTicker::riseFallValue, &futures::EventTicker::indexPrice,
+                                &futures::EventTicker::fairPrice, &futures::EventTicker::fundingRate,
+                                &futures::EventTicker::timestamp>;
+};
+
+template<>
+struct BinaryLayout<futures::EventCandlestick> {
+    static constexpr auto TYPE = BinaryType::EventCandlestick;
+    using Fields = BinaryFields<&futures::EventCandlestick::symbol, &futures::EventCandlestick::amount,
+                                &futures::EventCandlestick::interval, &futures::EventCandlestick::open,
+                                &futures::EventCandlestick::high, &futures::EventCandlestick::low,
+                                &futures::EventCandlestick::close, &futures::EventCandlestick::volume,
+                                &futures::EventCandlestick::start>;
+};
+
+/**
+ * Encode models
+ * @param items models of one type
+ * @return binary buffer
+ */
+template<typename T>
+std::string encodeBinary(std::span<const T> items) {
+    using Fields = typename BinaryLayout<T>::Fields;
+
+    if (items.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Too many items to encode");
+    }
+
+    std::string retVal(BINARY_HEADER_SIZE + items.size() * Fields::RECORD_SIZE, '\0');
+    detail::storeScalar(retVal, 0, BINARY_MAGIC);
+    detail::storeScalar(retVal, 4, BINARY_VERSION_MINOR);
+    detail::storeScalar(retVal, 5, BINARY_VERSION_MAJOR);
+    detail::storeScalar(retVal, 6, static_cast<std::uint16_t>(BinaryLayout<T>::TYPE));
+    detail::storeScalar(retVal, 8, static_cast<std::uint32_t>(items.size()));
+    detail::storeScalar(retVal, 12, static_cast<std::uint32_t>(Fields::RECORD_SIZE));
+
+    const auto storeString = [&retVal](const std::size_t pos, const std::string &value) {
+        detail::storeScalar(retVal, pos, detail::heapOffset(retVal));
+        detail::storeScalar(retVal, pos + 4, static_cast<std::uint32_t>(value.size()));
+        retVal.append(value);
+    };
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const auto record = BINARY_HEADER_SIZE + i * Fields::RECORD_SIZE;
+
+        Fields::forEach([&]<auto Member>(const std::size_t offset) {
+            using M = detail::BinaryMemberType<Member>;
+            const auto pos = record + offset;
+            const auto &value = items[i].*Member;
+
+            if constexpr (detail::IS_BINARY_STRING<M>) {
+                storeString(pos, value);
+            } else if constexpr (detail::IS_BINARY_STRING_LIST<M>) {
+                const auto list = detail::heapOffset(retVal);
+                retVal.append(value.size() * 8, '\0');
+
+                for (std::size_t j = 0; j < value.size(); ++j) {
+                    storeString(list + j * 8, value[j]);
+                }
+
+                detail::storeScalar(retVal, pos, list);
+                detail::storeScalar(retVal, pos + 4, static_cast<std::uint32_t>(value.size()));
+            } else if constexpr (std::is_same_v<M, Decimal>) {
+                detail::storeScalar(retVal, pos, value.mantissa());
+                detail::storeScalar(retVal, pos + 8, value.exponent());
+            } else if constexpr (detail::IsDecimal<M>::value) {
+                detail::storeScalar(retVal, pos, value.raw());
+            } else if constexpr (std::is_same_v<M, bool>) {
+                detail::storeScalar(retVal, pos, static_cast<std::uint8_t>(value));
+            } else {
+                detail::storeScalar(retVal, pos, value);
+            }
+        });
+    }
+
+    return retVal;
+}
+
+template<typename T>
+std::string encodeBinary(const std::vector<T> &items) {
+    return encodeBinary(std::span<const T>(items));
+}
+
+/**
+ * Zero-copy view of one encoded record
+ */
+template<typename T>
+class BinaryRecord {
+    using Fields = typename BinaryLayout<T>::Fields;
+
+    std::string_view m_buffer;
+    std::size_t m_offset{};
+
+public:
+    BinaryRecord(const std::string_view buffer, const std::size_t offset) : m_buffer(buffer), m_offset(offset) {
+    }
+
+    /**
+     * Read one field without decoding the others, e.g. record.get<&futures::Ticker::lastPrice>()
+     * @return the value, std::string_view for strings and BinaryStringList for string lists
+     */
+    template<auto Member>
+    [[nodiscard]] auto get() const {
+        using M = detail::BinaryMemberType<Member>;
+        const auto pos = m_offset + Fields::template offsetOf<Member>();
+
+        if constexpr (detail::IS_BINARY_STRING<M>) {
+            return detail::loadString(m_buffer, pos);
+        } else if constexpr (detail::IS_BINARY_STRING_LIST<M>) {
+            return BinaryStringList(m_buffer, detail::loadScalar<std::uint32_t>(m_buffer, pos),
+                                    detail::loadScalar<std::uint32_t>(m_buffer, pos + 4));
+        } else if constexpr (std::is_same_v<M, Decimal>) {
+            return Decimal::fromParts(detail::loadScalar<std::int64_t>(m_buffer, pos),
+                                      detail::loadScalar<std::int32_t>(m_buffer, pos + 8));
+        } else if constexpr (detail::IsDecimal<M>::value) {
+            return M::fromRaw(detail::loadScalar<std::int64_t>(m_buffer, pos));
+        } else if constexpr (std::is_same_v<M, bool>) {
+            return detail::loadScalar<std::uint8_t>(m_buffer, pos) != 0;
+        } else {
+            return detail::loadScalar<M>(m_buffer, pos);
+        }
+    }
+
+    /**
+     * Decode all fields
+     */
+    [[nodiscard]] T decode() const {
+        T retVal;
+
+        Fields::forEach([&]<auto Member>(std::size_t) {
+            using M = detail::BinaryMemberType<Member>;
+
+            if constexpr (detail::IS_BINARY_STRING_LIST<M>) {
+                const auto list = get<Member>();
+                auto &target = retVal.*Member;
+                target.clear();
+                target.reserve(list.size());
+
+                for (std::size_t i = 0; i < list.size(); ++i) {
+                    target.emplace_back(list[i]);
+                }
+            } else if constexpr (detail::IS_BINARY_STRING<M>) {
+                retVal.*Member = std::string(get<Member>());
+            } else {
+                retVal.*Member = get<Member>();
+            }
+        });
+
+        if constexpr (requires { retVal.symbolId; }) {
+            if (!retVal.symbol.empty()) {
+                retVal.symbolId = SymbolRegistry::instance().intern(retVal.symbol);
+            }
+        }
+
+        return retVal;
+    }
+};
+
+/**
+ * Zero-copy view of an encoded buffer, the buffer must outlive the view and the records
+ */
+template<typename T>
+class BinaryView {
+    std::string_view m_buffer;
+    std::size_t m_count{};
+    std::size_t m_recordSize{};
+
+public:
+    /**
+     * @param buffer result of encodeBinary
+     * @throws std::runtime_error if the buffer is not an encoding of T of the same major version, or its records lack
+     * fields of the layout
+     */
+    explicit BinaryView(const std::string_view buffer) : m_buffer(buffer) {
+        if (buffer.size() < BINARY_HEADER_SIZE || detail::loadScalar<std::uint32_t>(buffer, 0) != BINARY_MAGIC) {
+            throw std::runtime_error("Not a MEXC binary buffer");
+        }
+
+        if (detail::loadScalar<std::uint8_t>(buffer, 5) != BINARY_VERSION_MAJOR) {
+            throw std::runtime_error("Unsupported MEXC binary version");
+        }
+
+        if (detail::loadScalar<std::uint16_t>(buffer, 6) != static_cast<std::uint16_t>(BinaryLayout<T>::TYPE)) {
+            throw std::runtime_error("MEXC binary buffer contains another type");
+        }
+
+        m_count = detail::loadScalar<std::uint32_t>(buffer, 8);
+        m_recordSize = detail::loadScalar<std::uint32_t>(buffer, 12);
+
+        if (m_recordSize < BinaryLayout<T>::Fields::RECORD_SIZE) {
+            throw std::runtime_error("MEXC binary record is too small");
+        }
+
+        detail::checkRange(buffer, BINARY_HEADER_SIZE, static_cast<std::uint64_t>(m_count) * m_recordSize);
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return m_count;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] BinaryRecord<T> operator[](const std::size_t index) const {
+        if (index >= m_count) {
+            throw std::out_of_range("Binary record index out of range");
+        }
+
+        return BinaryRecord<T>(m_buffer, BINARY_HEADER_SIZE + index * m_recordSize);
+    }
+
+    [[nodiscard]] std::vector<T> decodeAll() const {
+        std::vector<T> retVal;
+        retVal.reserve(m_count);
+
+        for (std::size_t i = 0; i < m_count; ++i) {
+            retVal.push_back((*this)[i].decode());
+        }
+
+        return retVal;
+    }
+};
+
+/**
+ * Decode all models of a buffer
+ * @param buffer result of encodeBinary
+ */
+template<typename T>
+std::vector<T> decodeBinary(const std::string_view buffer) {
+    return BinaryView<T>(buffer).decodeAll();
+}
+}
+
+#endif // INCLUDE_VK_MEXC_BINARY_FORMAT_H
@@ -0,0 +1,123 @@
+/**
+MEXC Candle Columns
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_CANDLE_COLUMNS_H
+#define INCLUDE_VK_MEXC_CANDLE_COLUMNS_H
+
+#include "mexc_models.h"
+#include "mexc_enums.h"
+#include <cstdint>
+#include <vector>
+
+namespace vk::mexc {
+
+/**
+ * Candles stored column-wise, each field is one contiguous array so the analytics kernels below run over plain
+ * arrays which the compiler vectorizes. Rows are sorted by openTime in ascending order.
+ */
+struct CandleColumns {
+    std::vector<std::int64_t> openTime{}; ///< ms
+    std::vector<double> open{};
+    std::vector<double> high{};
+    std::vector<double> low{};
+    std::vector<double> close{};
+    std::vector<double> volume{};
+    std::vector<double> amount{};         ///< quote asset volume
+
+    [[nodiscard]] std::size_t size() const {
+        return openTime.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return openTime.empty();
+    }
+
+    void reserve(std::size_t count);
+
+    void clear();
+
+    void push_back(std::int64_t time, double o, double h, double l, double c, double v, double a);
+
+    /**
+     * Insert all rows of other before the current ones, used when the history is downloaded backward
+     * @param other older candles
+     */
+    void prepend(const CandleColumns &other);
+
+    /**
+     * Remove the last row
+     */
+    void pop_back();
+
+    /**
+     * Parse the data object of the futures kline response, the columns are copied without building Candle rows
+     * @param data object with time, open, high, low, close, vol and amount arrays, time in seconds
+     */
+    static CandleColumns fromFuturesJson(const nlohmann::json &data);
+
+    static CandleColumns fromCandles(const std::vector<futures::Candle> &candles);
+
+    static CandleColumns fromCandles(const std::vector<spot::Candle> &candles);
+};
+
+struct CandleGap {
+    std::size_t index{};            ///< index of the first candle after the gap
+    std::int64_t missingCandles{};  ///< negative when candles overlap or are out of order
+};
+
+/**
+ * Aggregate candles into a longer interval, e.g. 1m to 1h. Intraday and daily buckets are aligned to multiples
+ * of the target interval since the epoch, weeks start on Monday 00:00 UTC and months on the first day of the
+ * calendar month. Empty buckets are not emitted.
+ * @param candles source candles sorted by time
+ * @param sourceInterval interval of candles
+ * @param targetInterval target interval
+ * @throws std::invalid_argument if targetInterval is not a multiple of sourceInterval
+ * @return resampled candles
+ */
+CandleColumns resample(const CandleColumns &candles, CandleInterval sourceInterval, CandleInterval targetInterval);
+
+/**
+ * Minimum of each window ending at the given index, computed in O(n) with a monotonic queue. The first
+ * window - 1 values are computed from the shorter available window.
+ * @param values
+ * @param window window size, at least 1
+ * @return values.size() minimums
+ */
+std::vector<double> rollingMin(const std::vector<double> &values, std::size_t window);
+
+/**
+ * Maximum of each window ending at the given index, see rollingMin
+ */
+std::vector<double> rollingMax(const std::vector<double> &values, std::size_t window);
+
+/**
+ * Volume weighted average of the typical price (high + low + close) / 3
+ * @param candles
+ * @return vwap, 0 if there is no volume
+ */
+double vwap(const CandleColumns &candles);
+
+/**
+ * Returns of consecutive values
+ * @param values e.g. close prices
+ * @param logarithmic log returns instead of simple ones
+ * @return values.size() - 1 returns
+ */
+std::vector<double> returns(const std::vector<double> &values, bool logarithmic = false);
+
+/**
+ * Find places where the distance of consecutive candles is not exactly one interval
+ * @param candles candles sorted by time
+ * @param interval interval of the candles
+ * @return gaps
+ */
+std::vector<CandleGap> findGaps(const CandleColumns &candles, CandleInterval interval);
+}
+
+#endif // INCLUDE_VK_MEXC_CANDLE_COLUMNS_H
@@ -0,0 +1,76 @@
+/**
+MEXC Futures WebSocket Channel Registry
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_CHANNEL_REGISTRY_H
+#define INCLUDE_VK_MEXC_CHANNEL_REGISTRY_H
+
+#include "mexc_event_models.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vk::mexc::futures {
+/// Handler of one channel, the views of the frame are valid only during the call
+using onChannelFrame = std::function<void(const EventFrame &eventFrame)>;
+
+/**
+ * Map of channel names to their handlers. A perfect hash of the registered names is searched on each change, so
+ * the dispatch of a frame costs one hash of the channel name and one string comparison. Handlers are meant to be
+ * registered before the WebSocket session runs, the registry is not synchronized.
+ */
+class ChannelRegistry {
+    struct Entry {
+        std::string channel;
+        onChannelFrame handler;
+    };
+
+    static constexpr std::uint16_t EMPTY = 0xFFFF;
+
+    std::vector<Entry> m_entries;
+    std::vector<std::uint16_t> m_slots;
+    std::uint32_t m_seed{};
+    int m_slotBits{};
+
+    [[nodiscard]] std::size_t slotOf(std::string_view channel) const;
+
+    void rehash();
+
+public:
+    /**
+     * Register the handler of a channel, the handler of an already registered channel is replaced
+     * @param channel e.g. push.ticker
+     * @param handler
+     */
+    void set(std::string_view channel, onChannelFrame handler);
+
+    /**
+     * @param channel
+     * @return true if the channel was registered
+     */
+    bool erase(std::string_view channel);
+
+    /**
+     * @param channel
+     * @return handler, nullptr if the channel is not registered
+     */
+    [[nodiscard]] const onChannelFrame *find(std::string_view channel) const;
+
+    /**
+     * Call the handler of the frame's channel
+     * @param eventFrame
+     * @return false if the channel is not registered
+     */
+    bool dispatch(const EventFrame &eventFrame) const;
+
+    [[nodiscard]] std::size_t size() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_CHANNEL_REGISTRY_H
@@ -0,0 +1,65 @@
+/**
+MEXC Clock Synchronization
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_CLOCK_SYNC_H
+#define INCLUDE_VK_MEXC_CLOCK_SYNC_H
+
+#include <cstdint>
+#include <memory>
+
+namespace vk::mexc {
+
+/**
+ * Estimate of the offset between the local and the exchange clock. Each sample is a server timestamp bracketed by
+ * local timestamps taken just before the request was written and just after the response was read. As in NTP the
+ * server time is assumed to be taken in the middle of the round trip, so the sample with the shortest round trip in
+ * the recent window has the smallest error and is used as the estimate.
+ */
+class ClockSync {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    /// Number of recent samples the minimum round trip is searched in
+    static constexpr std::size_t WINDOW_SIZE = 16;
+
+    ClockSync();
+
+    ~ClockSync();
+
+    /**
+     * Add sample
+     * @param requestTime local time in ms just before the request was sent
+     * @param serverTime server time in ms from the response
+     * @param responseTime local time in ms just after the response was received
+     */
+    void addSample(std::int64_t requestTime, std::int64_t serverTime, std::int64_t responseTime) const;
+
+    /**
+     * @return true if at least one sample was added
+     */
+    [[nodiscard]] bool isSynchronized() const;
+
+    /**
+     * @return estimated server time minus local time in ms, 0 if not synchronized
+     */
+    [[nodiscard]] std::int64_t offset() const;
+
+    /**
+     * @return round trip in ms of the sample the offset was taken from
+     */
+    [[nodiscard]] std::int64_t roundTrip() const;
+
+    /**
+     * @return estimated current server time in ms, local time if not synchronized
+     */
+    [[nodiscard]] std::int64_t now() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_CLOCK_SYNC_H
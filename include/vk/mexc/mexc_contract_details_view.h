@@ -0,0 +1,151 @@
+/**
+MEXC Contract Details View
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_CONTRACT_DETAILS_VIEW_H
+#define INCLUDE_VK_MEXC_CONTRACT_DETAILS_VIEW_H
+
+#include "mexc_models.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vk::mexc::futures {
+/**
+ * One contract of ContractDetailsView, a view of its JSON object. Fields are decoded on each access, the object is
+ * valid as long as the ContractDetailsView it comes from.
+ */
+class ContractDetailRef {
+    std::string_view m_object;
+
+public:
+    explicit ContractDetailRef(const std::string_view object) : m_object(object) {
+    }
+
+    /**
+     * @return raw JSON text of the contract object
+     */
+    [[nodiscard]] std::string_view json() const {
+        return m_object;
+    }
+
+    /**
+     * Find the raw value of a field, strings are returned without quotes and with escape sequences undecoded
+     * @param key field name, e.g. "contractSize"
+     * @return raw value, std::nullopt if the field is missing or null
+     */
+    [[nodiscard]] std::optional<std::string_view> rawValue(std::string_view key) const;
+
+    [[nodiscard]] std::string getString(std::string_view key) const;
+
+    [[nodiscard]] double getDouble(std::string_view key, double defaultValue = 0.0) const;
+
+    [[nodiscard]] std::int64_t getInt(std::string_view key, std::int64_t defaultValue = 0) const;
+
+    [[nodiscard]] bool getBool(std::string_view key, bool defaultValue = false) const;
+
+    [[nodiscard]] std::string symbol() const {
+        return getString("symbol");
+    }
+
+    [[nodiscard]] double contractSize() const {
+        return getDouble("contractSize", 1.0);
+    }
+
+    [[nodiscard]] double priceUnit() const {
+        return getDouble("priceUnit", 1.0);
+    }
+
+    [[nodiscard]] double volUnit() const {
+        return getDouble("volUnit", 1.0);
+    }
+
+    [[nodiscard]] std::int32_t pricePrecision() const {
+        return static_cast<std::int32_t>(getInt("pricePrecision", 2));
+    }
+
+    [[nodiscard]] std::int32_t volPrecision() const {
+        return static_cast<std::int32_t>(getInt("volPrecision", 0));
+    }
+
+    /**
+     * Decode all fields
+     * @return ContractDetail
+     */
+    [[nodiscard]] ContractDetail decode() const;
+};
+
+/**
+ * Lazily decoded response of /api/v1/contract/detail. The raw response body is kept together with the offsets of
+ * the contract objects, which are found by one scan without building a DOM. Only the fields which are accessed are
+ * decoded, it is much cheaper than ContractDetails when a few fields of a few contracts are needed.
+ */
+class ContractDetailsView {
+    struct Entry {
+        std::uint32_t begin{};
+        std::uint32_t length{};
+        std::uint32_t symbolBegin{};
+        std::uint32_t symbolLength{};
+    };
+
+    std::string m_body;
+    int m_code{};
+    bool m_success{};
+    std::vector<Entry> m_entries;
+
+    /// Indexes of m_entries sorted by symbol
+    std::vector<std::uint32_t> m_bySymbol;
+
+    [[nodiscard]] std::string_view symbolOf(const Entry &entry) const {
+        return std::string_view(m_body).substr(entry.symbolBegin, entry.symbolLength);
+    }
+
+public:
+    ContractDetailsView() = default;
+
+    /**
+     * Index the response
+     * @param body raw response body
+     * @throws std::runtime_error if the body is not valid JSON
+     */
+    explicit ContractDetailsView(std::string body);
+
+    [[nodiscard]] int code() const {
+        return m_code;
+    }
+
+    [[nodiscard]] bool success() const {
+        return m_success;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return m_entries.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return m_entries.empty();
+    }
+
+    [[nodiscard]] ContractDetailRef operator[](std::size_t index) const;
+
+    /**
+     * Find contract by symbol in O(log n)
+     * @param symbol e.g. BTC_USDT
+     * @return contract, std::nullopt if not found
+     */
+    [[nodiscard]] std::optional<ContractDetailRef> find(std::string_view symbol) const;
+
+    /**
+     * Decode all contracts, equivalent to ContractDetails
+     */
+    [[nodiscard]] std::vector<ContractDetail> decodeAll() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_CONTRACT_DETAILS_VIEW_H
@@ -0,0 +1,113 @@
+/**
+MEXC Contract Index
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_CONTRACT_INDEX_H
+#define INCLUDE_VK_MEXC_CONTRACT_INDEX_H
+
+#include "mexc_models.h"
+#include "mexc_symbol_registry.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vk::mexc::futures {
+enum class Rounding : std::int32_t {
+    Nearest,
+    Down,
+    Up
+};
+
+/**
+ * Trading rules of one contract with the values needed for rounding precomputed
+ */
+struct ContractRules {
+    std::string symbol{};
+    ContractState state{ContractState::Enabled};
+    bool apiAllowed{true};
+    double contractSize{1.0};
+    double priceUnit{1.0};          ///< tick size
+    double volUnit{1.0};            ///< volume step in contracts
+    double minVol{1.0};
+    double maxVol{1000000.0};
+    std::int32_t pricePrecision{2};
+    std::int32_t volPrecision{0};
+    double inversePriceUnit{1.0};   ///< 1 / priceUnit
+    double inverseVolUnit{1.0};     ///< 1 / volUnit
+    double priceScale{100.0};       ///< 10^pricePrecision
+    double volScale{1.0};           ///< 10^volPrecision
+    double inversePriceScale{0.01}; ///< 10^-pricePrecision
+    double inverseVolScale{1.0};    ///< 10^-volPrecision
+
+    [[nodiscard]] bool isTradable() const {
+        return state == ContractState::Enabled && apiAllowed;
+    }
+
+    /**
+     * Round price to a multiple of the tick size
+     * @param price
+     * @param rounding e.g. Rounding::Down for buy limit prices which must not be worse than the given one
+     * @return rounded price without floating point noise below pricePrecision
+     */
+    [[nodiscard]] double roundPrice(double price, Rounding rounding = Rounding::Nearest) const;
+
+    /**
+     * Round volume to a multiple of the volume step
+     * @param volume number of contracts
+     * @param rounding Rounding::Down does not exceed the requested volume
+     * @return rounded volume
+     */
+    [[nodiscard]] double roundVolume(double volume, Rounding rounding = Rounding::Down) const;
+
+    [[nodiscard]] bool isPriceOnTick(double price) const;
+
+    [[nodiscard]] bool isVolumeOnStep(double volume) const;
+};
+
+/**
+ * Trading rules of all contracts indexed by SymbolId. It is built once from getContractDetails() and used to round
+ * and validate orders locally, so the requests which the exchange would reject are not sent at all.
+ */
+class ContractIndex {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    explicit ContractIndex(const std::vector<ContractDetail> &contractDetails);
+
+    ~ContractIndex();
+
+    /**
+     * @param symbol e.g. BTC_USDT
+     * @return rules, nullptr if the contract is not in the index
+     */
+    [[nodiscard]] const ContractRules *find(std::string_view symbol) const;
+
+    [[nodiscard]] const ContractRules *find(SymbolId symbolId) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * Check the order against the rules of its contract: the contract is tradable, the volume is within the limits
+     * and on the volume step and the prices are on the tick
+     * @param request
+     * @return description of the first violation, std::nullopt if the order is valid
+     */
+    [[nodiscard]] std::optional<std::string> validate(const OrderRequest &request) const;
+
+    /**
+     * Round the prices to the nearest tick and the volume down to the volume step
+     * @param request
+     * @return false if the contract is not in the index, the request is not changed then
+     */
+    bool normalize(OrderRequest &request) const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_CONTRACT_INDEX_H
@@ -10,6 +10,9 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #define INCLUDE_VK_MEXC_EVENT_MODELS_V5_H
 
 #include "mexc_enums.h"
+#include "mexc_json_scanner.h"
+#include "mexc_models.h"
+#include "mexc_symbol_registry.h"
 #include "vk/interface/i_json.h"
 #include <nlohmann/json.hpp>
 
@@ -37,6 +40,7 @@ struct WSSubscription final : IJson {
 struct Event final : IJson {
 	std::string channel{};
 	std::string symbol{};
+	SymbolId symbolId{INVALID_SYMBOL_ID}; ///< interned symbol, INVALID_SYMBOL_ID for events without a symbol
 	std::int64_t ts{};
 	nlohmann::json data{};
 
@@ -47,8 +51,27 @@ struct Event final : IJson {
 	void fromJson(const nlohmann::json &json) override;
 };
 
+/**
+ * Envelope of a push frame scanned without building a DOM, the views point into the frame
+ */
+struct EventFrame {
+	std::string_view text{}; ///< whole frame
+	std::string_view channel{};
+	std::string_view symbol{};
+	std::int64_t ts{};
+	std::string_view data{}; ///< raw JSON of the data member, decoded by the typed parser of the channel
+
+	/**
+	 * Scan the top level members of the frame
+	 * @param frame received text, it must outlive the EventFrame
+	 * @return false if the frame is not a JSON object
+	 */
+	bool scan(std::string_view frame);
+};
+
 struct EventTicker final : IJson {
 	std::string symbol{};
+	SymbolId symbolId{INVALID_SYMBOL_ID};
 	double bid1{};
 	double ask1{};
 	double volume24{};
@@ -65,10 +88,17 @@ struct EventTicker final : IJson {
 	[[nodiscard]] nlohmann::json toJson() const override;
 
 	void fromJson(const nlohmann::json &json) override;
+
+	/**
+	 * Decode the data member of a push frame straight from its text
+	 * @param scanner positioned at the data object, see EventFrame::data
+	 */
+	void fromJson(JsonScanner &scanner);
 };
 
 struct EventCandlestick final : IJson {
 	std::string symbol{};
+	SymbolId symbolId{INVALID_SYMBOL_ID};
 	double amount{};
 	CandleInterval interval{};
 	double open{};
@@ -81,6 +111,33 @@ struct EventCandlestick final : IJson {
 	[[nodiscard]] nlohmann::json toJson() const override;
 
 	void fromJson(const nlohmann::json &json) override;
+
+	/**
+	 * Decode the data member of a push frame straight from its text
+	 * @param scanner positioned at the data object, see EventFrame::data
+	 */
+	void fromJson(JsonScanner &scanner);
+};
+
+/// Order book update of push.depth (incremental) or push.depth.full (snapshot of the top levels)
+struct EventDepth final : IJson {
+	std::string symbol{};
+	SymbolId symbolId{INVALID_SYMBOL_ID};
+	bool isSnapshot{false};
+	std::int64_t version{};
+	std::int64_t ts{};
+	std::vector<DepthLevel> asks{};
+	std::vector<DepthLevel> bids{};
+
+	[[nodiscard]] nlohmann::json toJson() const override;
+
+	void fromJson(const nlohmann::json &json) override;
+
+	/**
+	 * Decode the data member of a push frame straight from its text, the prices are parsed exactly
+	 * @param scanner positioned at the data object, see EventFrame::data
+	 */
+	void fromJson(JsonScanner &scanner);
 };
 }
 #endif //INCLUDE_VK_MEXC_EVENT_MODELS_V5_H
@@ -0,0 +1,294 @@
+/**
+MEXC Event Queue
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_EVENT_QUEUE_H
+#define INCLUDE_VK_MEXC_EVENT_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace vk::mexc {
+enum class OverflowPolicy : std::int32_t {
+    DropNewest, ///< the pushed event is discarded
+    DropOldest, ///< the oldest queued event is discarded to make room
+    Block       ///< the producer waits for room at most blockTimeout, i.e. the IO thread stops reading meanwhile
+};
+
+struct EventQueueSettings {
+    /// Rounded up to a power of two, all slots are allocated upfront
+    std::size_t capacity{4096};
+    OverflowPolicy overflowPolicy{OverflowPolicy::DropNewest};
+    /// OverflowPolicy::Block only, the event is dropped when the consumer does not make room in time
+    std::chrono::milliseconds blockTimeout{1000};
+};
+
+/**
+ * Bounded lock-free queue passing events from the IO threads to one consumer. It is the array based MPMC queue of
+ * Dmitry Vyukov: each slot carries a sequence number telling whether it is free for the producer of the lap or filled
+ * for the consumer, so producers and consumers only contend on their own position counter. Several IO threads may
+ * push concurrently. The consumer polls with tryPop or sleeps in pop, the producers only touch the mutex when the
+ * consumer is sleeping or the queue is full under OverflowPolicy::Block, the consumer only when producers wait.
+ * @tparam T event type, must be default constructible and move assignable
+ */
+template<typename T>
+class EventQueue {
+    /// Aligned to a cache line, so the producer and the consumer of the adjacent slots do not share it
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{};
+        T value{};
+    };
+
+    const std::size_t m_mask;
+    const OverflowPolicy m_overflowPolicy;
+    const std::chrono::milliseconds m_blockTimeout;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+    alignas(64) std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<int> m_waiters{0};
+    std::atomic<int> m_blockedProducers{0};
+    std::atomic<bool> m_isClosed{false};
+    std::mutex m_mutex;
+    /// The consumer waits for an event
+    std::condition_variable m_condition;
+    /// The producers of OverflowPolicy::Block wait for room
+    std::condition_variable m_notFull;
+
+    template<typename U>
+    bool tryPush(U &&value) {
+        auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            auto &cell = m_cells[pos & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::forward<U>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryDequeue(T &value) {
+        auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            auto &cell = m_cells[pos & m_mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Wake the consumer sleeping in pop, the fence pairs with the one in pop so a pushed event is never missed
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (m_waiters.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard lock(m_mutex);
+            m_condition.notify_all();
+        }
+    }
+
+    /// Wake the producers blocked by a full queue, the fence pairs with the one in waitForRoom
+    void notifyNotFull() {
+        if (m_overflowPolicy != OverflowPolicy::Block) {
+            return;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (m_blockedProducers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard lock(m_mutex);
+            m_notFull.notify_all();
+        }
+    }
+
+    /**
+     * Wait at most blockTimeout until the value is pushed
+     * @return false if the timeout expired or the queue was closed
+     */
+    template<typename U>
+    bool waitForRoom(U &&value) {
+        std::unique_lock lock(m_mutex);
+        m_blockedProducers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto isPushed = false;
+        m_notFull.wait_for(lock, m_blockTimeout, [&] {
+            /// The value is moved from only when it is pushed
+            isPushed = tryPush(std::forward<U>(value));
+            return isPushed || m_isClosed.load(std::memory_order_relaxed);
+        });
+
+        m_blockedProducers.fetch_sub(1, std::memory_order_relaxed);
+        return isPushed;
+    }
+
+public:
+    explicit EventQueue(const EventQueueSettings &settings = {})
+        : m_mask(std::bit_ceil(std::max<std::size_t>(settings.capacity, 2)) - 1),
+          m_overflowPolicy(settings.overflowPolicy),
+          m_blockTimeout(settings.blockTimeout),
+          m_cells(std::make_unique<Cell[]>(m_mask + 1)) {
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventQueue(const EventQueue &) = delete;
+
+    EventQueue &operator=(const EventQueue &) = delete;
+
+    /**
+     * Push event according to the overflow policy, called by the producers
+     * @param value
+     * @return false if the event was dropped or the queue is closed
+     */
+    template<typename U>
+    bool push(U &&value) {
+        for (;;) {
+            if (m_isClosed.load(std::memory_order_relaxed)) {
+                return false;
+            }
+
+            if (tryPush(std::forward<U>(value))) {
+                notify();
+                return true;
+            }
+
+            switch (m_overflowPolicy) {
+            case OverflowPolicy::DropOldest:
+                if (T oldest; tryDequeue(oldest)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            case OverflowPolicy::Block:
+                if (waitForRoom(std::forward<U>(value))) {
+                    notify();
+                    return true;
+                }
+
+                if (!m_isClosed.load(std::memory_order_relaxed)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                return false;
+            default:
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+    }
+
+    /**
+     * Pop the oldest event without blocking
+     * @param value receives the event
+     * @return false if the queue is empty
+     */
+    bool tryPop(T &value) {
+        if (tryDequeue(value)) {
+            notifyNotFull();
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Pop the oldest event, wait for one if the queue is empty
+     * @param value receives the event
+     * @param timeout
+     * @return false if the timeout expired or the queue was closed and is empty
+     */
+    bool pop(T &value, const std::chrono::milliseconds timeout) {
+        if (tryPop(value)) {
+            return true;
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto isPopped = false;
+        m_condition.wait_for(lock, timeout, [&] {
+            isPopped = tryDequeue(value);
+            return isPopped || m_isClosed.load(std::memory_order_relaxed);
+        });
+
+        m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        if (isPopped && m_overflowPolicy == OverflowPolicy::Block) {
+            /// The mutex is held, the blocked producers cannot miss the notification
+            m_notFull.notify_all();
+        }
+
+        return isPopped;
+    }
+
+    /**
+     * Reject further events and wake the consumer and the blocked producers, the queued events can still be popped
+     */
+    void close() {
+        m_isClosed.store(true, std::memory_order_relaxed);
+        std::lock_guard lock(m_mutex);
+        m_condition.notify_all();
+        m_notFull.notify_all();
+    }
+
+    [[nodiscard]] bool isClosed() const {
+        return m_isClosed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return number of queued events, approximate while the producers or the consumer are active
+     */
+    [[nodiscard]] std::size_t size() const {
+        const auto dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+        const auto enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const {
+        return m_mask + 1;
+    }
+
+    /**
+     * @return number of events discarded by the overflow policies, including the Block timeouts
+     */
+    [[nodiscard]] std::uint64_t dropped() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+};
+}
+
+#endif // INCLUDE_VK_MEXC_EVENT_QUEUE_H
@@ -0,0 +1,617 @@
+/**
+MEXC Fixed-Point Decimal
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_FIXED_DECIMAL_H
+#define INCLUDE_VK_MEXC_FIXED_DECIMAL_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace vk::mexc {
+
+namespace detail {
+constexpr std::array<std::uint64_t, 20> POWERS_OF_10 = [] {
+    std::array<std::uint64_t, 20> retVal{};
+    std::uint64_t value = 1;
+
+    for (auto &power: retVal) {
+        power = value;
+        value *= 10;
+    }
+
+    return retVal;
+}();
+}
+
+/**
+ * Decimal number stored as int64 scaled by 10^Scale. It is parsed exactly from the decimal text sent by MEXC,
+ * digits beyond the scale are rounded half away from zero. The interface mirrors the subset of
+ * boost::multiprecision::cpp_dec_float_50 used by the models (assign, convert_to, str).
+ * @tparam Scale number of decimal places, the representable range is +-9.2e18 / 10^Scale
+ */
+template<int Scale>
+class FixedDecimal {
+    static_assert(Scale >= 0 && Scale <= 18, "FixedDecimal scale must be in the range 0 - 18");
+
+    std::int64_t m_value{};
+
+    static constexpr std::uint64_t ONE = detail::POWERS_OF_10[Scale];
+
+    [[noreturn]] static void invalid(const std::string_view text) {
+        throw std::runtime_error("Invalid decimal value: " + std::string(text));
+    }
+
+public:
+    static constexpr int scale = Scale;
+
+    constexpr FixedDecimal() = default;
+
+    explicit FixedDecimal(const std::string_view text) {
+        assign(text);
+    }
+
+    /**
+     * @param raw value multiplied by 10^Scale
+     */
+    static constexpr FixedDecimal fromRaw(const std::int64_t raw) {
+        FixedDecimal retVal;
+        retVal.m_value = raw;
+        return retVal;
+    }
+
+    /**
+     * @return value multiplied by 10^Scale
+     */
+    [[nodiscard]] constexpr std::int64_t raw() const {
+        return m_value;
+    }
+
+    /**
+     * Parse decimal text, e.g. "-123.456" or "1.5E-7", an empty text is zero
+     * @param text
+     * @throws std::runtime_error if the text is not a number or it is out of range
+     */
+    void assign(const std::string_view text) {
+        std::size_t pos = 0;
+        bool isNegative = false;
+
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+            isNegative = text[pos++] == '-';
+        }
+
+        /// value = mantissa * 10^exponent, 19 significant digits are kept which is the int64 range anyway
+        std::uint64_t mantissa = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+        bool hasPoint = false;
+        int firstDroppedDigit = -1;
+
+        for (; pos < text.size(); ++pos) {
+            if (const char c = text[pos]; c >= '0' && c <= '9') {
+                hasDigits = true;
+
+                if (mantissa < detail::POWERS_OF_10[18]) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+                    exponent -= hasPoint;
+                } else {
+                    if (firstDroppedDigit < 0) {
+                        firstDroppedDigit = c - '0';
+                    }
+                    exponent += !hasPoint;
+                }
+            } else if (c == '.' && !hasPoint) {
+                hasPoint = true;
+            } else {
+                break;
+            }
+        }
+
+        if (!hasDigits) {
+            if (text.empty()) {
+                m_value = 0;
+                return;
+            }
+            invalid(text);
+        }
+
+        if (firstDroppedDigit >= 5) {
+            ++mantissa;
+        }
+
+        if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+            ++pos;
+            bool isExponentNegative = false;
+
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+                isExponentNegative = text[pos++] == '-';
+            }
+
+            int value = 0;
+            const auto start = pos;
+
+            for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && value < 1000; ++pos) {
+                value = value * 10 + (text[pos] - '0');
+            }
+
+            if (pos == start) {
+                invalid(text);
+            }
+
+            exponent += isExponentNegative ? -value : value;
+        }
+
+        if (pos != text.size()) {
+            invalid(text);
+        }
+
+        if (const auto shift = exponent + Scale; shift >= 0) {
+            if (mantissa != 0 && (shift > 18 || mantissa > static_cast<std::uint64_t>(
+                                      std::numeric_limits<std::int64_t>::max()) / detail::POWERS_OF_10[shift])) {
+                throw std::runtime_error("Decimal value out of range: " + std::string(text));
+            }
+            mantissa *= detail::POWERS_OF_10[shift];
+        } else if (-shift >= static_cast<int>(detail::POWERS_OF_10.size())) {
+            mantissa = 0;
+        } else {
+            const auto divisor = detail::POWERS_OF_10[-shift];
+            mantissa = mantissa / divisor + (mantissa % divisor >= divisor / 2 ? 1 : 0);
+        }
+
+        if (mantissa > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            throw std::runtime_error("Decimal value out of range: " + std::string(text));
+        }
+
+        m_value = isNegative ? -static_cast<std::int64_t>(mantissa) : static_cast<std::int64_t>(mantissa);
+    }
+
+    /**
+     * Assign JSON number. The shortest decimal text which round-trips to the same double is parsed, it is the exact
+     * text of the number as long as it was sent with at most 15 significant digits. Nothing is allocated.
+     * @param value
+     * @throws std::runtime_error if the value is not finite or it is out of range
+     */
+    void assign(const double value) {
+        char buffer[32];
+        const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+        if (ec != std::errc()) {
+            throw std::runtime_error("Invalid decimal value");
+        }
+
+        assign(std::string_view(buffer, static_cast<std::size_t>(ptr - buffer)));
+    }
+
+    /**
+     * Convert to a floating point type, an integral type or std::string, integral conversion truncates the
+     * fractional part
+     */
+    template<typename T>
+    [[nodiscard]] T convert_to() const {
+        static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>,
+                      "FixedDecimal can be converted to an arithmetic type or std::string only");
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            return str();
+        } else if constexpr (std::is_floating_point_v<T>) {
+            /// Both operands are exact when |value| < 2^53, the division then gives the closest double
+            return static_cast<T>(m_value) / static_cast<T>(ONE);
+        } else {
+            return static_cast<T>(m_value / static_cast<std::int64_t>(ONE));
+        }
+    }
+
+    /**
+     * Format the value
+     * @param precision number of decimal places when fixed flag is set
+     * @param flags std::ios_base::fixed for a fixed number of decimal places, otherwise trailing zeros are removed
+     * @return formatted value
+     */
+    [[nodiscard]] std::string str(std::streamsize precision = 0, const std::ios_base::fmtflags flags = {}) const {
+        const bool isFixed = (flags & std::ios_base::fixed) != 0;
+        precision = std::max<std::streamsize>(precision, 0);
+        const bool isNegative = m_value < 0;
+        auto magnitude = isNegative ? 0 - static_cast<std::uint64_t>(m_value) : static_cast<std::uint64_t>(m_value);
+
+        if (isFixed && precision < Scale) {
+            /// Round half away from zero to the requested precision
+            const auto divisor = detail::POWERS_OF_10[Scale - precision];
+            const auto remainder = magnitude % divisor;
+            magnitude = magnitude - remainder + (remainder >= divisor / 2 ? divisor : 0);
+        }
+
+        std::string retVal = std::to_string(magnitude / ONE);
+        std::string fraction = std::to_string(magnitude % ONE);
+        fraction.insert(0, Scale - fraction.size(), '0');
+
+        if (isFixed) {
+            fraction.resize(static_cast<std::size_t>(precision), '0');
+        } else {
+            fraction.erase(fraction.find_last_not_of('0') + 1);
+        }
+
+        if (!fraction.empty()) {
+            retVal.append(".");
+            retVal.append(fraction);
+        }
+
+        if (isNegative && magnitude != 0) {
+            retVal.insert(0, "-");
+        }
+
+        return retVal;
+    }
+
+    constexpr auto operator<=>(const FixedDecimal &) const = default;
+
+    constexpr FixedDecimal operator-() const {
+        return fromRaw(-m_value);
+    }
+
+    constexpr FixedDecimal operator+(const FixedDecimal &other) const {
+        return fromRaw(m_value + other.m_value);
+    }
+
+    constexpr FixedDecimal operator-(const FixedDecimal &other) const {
+        return fromRaw(m_value - other.m_value);
+    }
+
+    constexpr FixedDecimal &operator+=(const FixedDecimal &other) {
+        m_value += other.m_value;
+        return *this;
+    }
+
+    constexpr FixedDecimal &operator-=(const FixedDecimal &other) {
+        m_value -= other.m_value;
+        return *this;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const FixedDecimal &value) {
+        return os << value.str();
+    }
+};
+
+/**
+ * Decimal number stored as int64 mantissa and decimal exponent, value = mantissa * 10^exponent. Unlike FixedDecimal
+ * the scale is given by the value, so up to 18 significant digits are kept at any magnitude, e.g. spot prices below
+ * 1e-8 as well as base asset volumes above 1e13. It is parsed exactly from the decimal text sent by MEXC, digits
+ * beyond the 18th are rounded half away from zero. The mantissa has no trailing zeros, so each value has exactly
+ * one representation and equal values have equal members. The interface mirrors FixedDecimal.
+ */
+class Decimal {
+    static constexpr int MAX_DIGITS = 18;
+
+    std::int64_t m_mantissa{};
+    std::int32_t m_exponent{};
+
+    [[noreturn]] static void invalid(const std::string_view text) {
+        throw std::runtime_error("Invalid decimal value: " + std::string(text));
+    }
+
+    static constexpr int digitCount(const std::uint64_t value) {
+        int retVal = 1;
+
+        while (retVal < static_cast<int>(detail::POWERS_OF_10.size()) && value >= detail::POWERS_OF_10[retVal]) {
+            ++retVal;
+        }
+
+        return retVal;
+    }
+
+    static double powerOf10(const int exponent) {
+        static constexpr std::array<double, 23> POWERS = [] {
+            std::array<double, 23> retVal{};
+            double value = 1.0;
+
+            for (auto &power: retVal) {
+                power = value;
+                value *= 10.0;
+            }
+
+            return retVal;
+        }();
+
+        const auto magnitude = exponent < 0 ? -exponent : exponent;
+        /// Exact up to 10^22, larger powers are rare enough to be computed
+        return magnitude < static_cast<int>(POWERS.size()) ? POWERS[magnitude] : std::pow(10.0, magnitude);
+    }
+
+    [[nodiscard]] constexpr std::uint64_t magnitude() const {
+        return m_mantissa < 0 ? 0 - static_cast<std::uint64_t>(m_mantissa) : static_cast<std::uint64_t>(m_mantissa);
+    }
+
+public:
+    constexpr Decimal() = default;
+
+    explicit Decimal(const std::string_view text) {
+        assign(text);
+    }
+
+    /**
+     * @param mantissa
+     * @param exponent
+     * @return mantissa * 10^exponent
+     */
+    static constexpr Decimal fromParts(std::int64_t mantissa, std::int32_t exponent) {
+        Decimal retVal;
+
+        if (mantissa != 0) {
+            while (mantissa % 10 == 0) {
+                mantissa /= 10;
+                ++exponent;
+            }
+
+            retVal.m_mantissa = mantissa;
+            retVal.m_exponent = exponent;
+        }
+
+        return retVal;
+    }
+
+    [[nodiscard]] constexpr std::int64_t mantissa() const {
+        return m_mantissa;
+    }
+
+    [[nodiscard]] constexpr std::int32_t exponent() const {
+        return m_exponent;
+    }
+
+    [[nodiscard]] constexpr bool isZero() const {
+        return m_mantissa == 0;
+    }
+
+    /**
+     * Parse decimal text, e.g. "-123.456", "0.0000000012" or "1.5E-7", an empty text is zero
+     * @param text
+     * @throws std::runtime_error if the text is not a number
+     */
+    void assign(const std::string_view text) {
+        std::size_t pos = 0;
+        bool isNegative = false;
+
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+            isNegative = text[pos++] == '-';
+        }
+
+        std::uint64_t mantissa = 0;
+        std::int64_t exponent = 0;
+        bool hasDigits = false;
+        bool hasPoint = false;
+        int firstDroppedDigit = -1;
+
+        for (; pos < text.size(); ++pos) {
+            if (const char c = text[pos]; c >= '0' && c <= '9') {
+                hasDigits = true;
+
+                if (mantissa < detail::POWERS_OF_10[MAX_DIGITS - 1]) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(c - '0');
+                    exponent -= hasPoint;
+                } else {
+                    if (firstDroppedDigit < 0) {
+                        firstDroppedDigit = c - '0';
+                    }
+                    exponent += !hasPoint;
+                }
+            } else if (c == '.' && !hasPoint) {
+                hasPoint = true;
+            } else {
+                break;
+            }
+        }
+
+        if (!hasDigits) {
+            if (text.empty()) {
+                *this = {};
+                return;
+            }
+            invalid(text);
+        }
+
+        if (firstDroppedDigit >= 5) {
+            ++mantissa;
+        }
+
+        if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+            ++pos;
+            bool isExponentNegative = false;
+
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+                isExponentNegative = text[pos++] == '-';
+            }
+
+            std::int64_t value = 0;
+            const auto start = pos;
+
+            for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && value < 100000; ++pos) {
+                value = value * 10 + (text[pos] - '0');
+            }
+
+            if (pos == start) {
+                invalid(text);
+            }
+
+            exponent += isExponentNegative ? -value : value;
+        }
+
+        if (pos != text.size()) {
+            invalid(text);
+        }
+
+        const auto signedMantissa = static_cast<std::int64_t>(mantissa);
+        *this = fromParts(isNegative ? -signedMantissa : signedMantissa, static_cast<std::int32_t>(exponent));
+    }
+
+    /**
+     * Assign JSON number, the shortest decimal text which round-trips to the same double is parsed. Prefer the
+     * text overload when the original token is available, this one keeps at most 17 significant digits.
+     * @param value
+     * @throws std::runtime_error if the value is not finite
+     */
+    void assign(const double value) {
+        char buffer[32];
+        const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+        if (ec != std::errc()) {
+            throw std::runtime_error("Invalid decimal value");
+        }
+
+        assign(std::string_view(buffer, static_cast<std::size_t>(ptr - buffer)));
+    }
+
+    /**
+     * Convert to a floating point type, an integral type or std::string, integral conversion truncates the
+     * fractional part
+     */
+    template<typename T>
+    [[nodiscard]] T convert_to() const {
+        static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>,
+                      "Decimal can be converted to an arithmetic type or std::string only");
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            return str();
+        } else if constexpr (std::is_floating_point_v<T>) {
+            /// Both operands are exact when |mantissa| < 2^53 and |exponent| <= 22, the result is the closest double
+            const auto mantissa = static_cast<double>(m_mantissa);
+            return static_cast<T>(m_exponent < 0 ? mantissa / powerOf10(m_exponent) : mantissa * powerOf10(m_exponent));
+        } else if (m_exponent >= 0) {
+            return static_cast<T>(m_mantissa * static_cast<std::int64_t>(detail::POWERS_OF_10[
+                std::min(m_exponent, static_cast<std::int32_t>(MAX_DIGITS))]));
+        } else if (-m_exponent > MAX_DIGITS) {
+            return T{};
+        } else {
+            return static_cast<T>(m_mantissa / static_cast<std::int64_t>(detail::POWERS_OF_10[-m_exponent]));
+        }
+    }
+
+    /**
+     * Format the value
+     * @param precision number of decimal places when fixed flag is set
+     * @param flags std::ios_base::fixed for a fixed number of decimal places, otherwise only the significant digits
+     * @return formatted value
+     */
+    [[nodiscard]] std::string str(std::streamsize precision = 0, const std::ios_base::fmtflags flags = {}) const {
+        const bool isFixed = (flags & std::ios_base::fixed) != 0;
+        precision = std::max<std::streamsize>(precision, 0);
+        auto digits = magnitude();
+        std::int64_t exponent = m_exponent;
+
+        if (isFixed && -exponent > precision) {
+            /// Round half away from zero to the requested precision
+            if (const auto dropped = -exponent - precision; dropped > MAX_DIGITS) {
+                digits = 0;
+            } else {
+                const auto divisor = detail::POWERS_OF_10[dropped];
+                digits = digits / divisor + (digits % divisor >= divisor / 2 ? 1 : 0);
+            }
+
+            exponent = -precision;
+        }
+
+        std::string text = std::to_string(digits);
+
+        if (exponent > 0) {
+            text.append(static_cast<std::size_t>(exponent), '0');
+        }
+
+        std::string fraction;
+
+        if (exponent < 0) {
+            const auto places = static_cast<std::size_t>(-exponent);
+
+            if (text.size() <= places) {
+                text.insert(0, places - text.size() + 1, '0');
+            }
+
+            fraction = text.substr(text.size() - places);
+            text.resize(text.size() - places);
+        }
+
+        if (isFixed) {
+            fraction.resize(static_cast<std::size_t>(precision), '0');
+        } else {
+            fraction.erase(fraction.find_last_not_of('0') + 1);
+        }
+
+        if (!fraction.empty()) {
+            text.append(".");
+            text.append(fraction);
+        }
+
+        if (m_mantissa < 0 && digits != 0) {
+            text.insert(0, "-");
+        }
+
+        return text;
+    }
+
+    constexpr bool operator==(const Decimal &) const = default;
+
+    constexpr std::strong_ordering operator<=>(const Decimal &other) const {
+        const auto sign = (m_mantissa > 0) - (m_mantissa < 0);
+
+        if (const auto otherSign = (other.m_mantissa > 0) - (other.m_mantissa < 0); sign != otherSign) {
+            return sign <=> otherSign;
+        }
+
+        if (sign == 0) {
+            return std::strong_ordering::equal;
+        }
+
+        /// Compare the magnitudes by the position of the leading digit, then by the digits aligned to it
+        auto digits = magnitude();
+        auto otherDigits = other.magnitude();
+        const auto count = digitCount(digits);
+        const auto otherCount = digitCount(otherDigits);
+        std::strong_ordering retVal = std::strong_ordering::equal;
+
+        if (const auto lead = static_cast<std::int64_t>(m_exponent) + count,
+                otherLead = static_cast<std::int64_t>(other.m_exponent) + otherCount; lead != otherLead) {
+            retVal = lead <=> otherLead;
+        } else {
+            if (count < otherCount) {
+                digits *= detail::POWERS_OF_10[otherCount - count];
+            } else {
+                otherDigits *= detail::POWERS_OF_10[count - otherCount];
+            }
+
+            retVal = digits <=> otherDigits;
+        }
+
+        return sign > 0 ? retVal : 0 <=> retVal;
+    }
+
+    constexpr Decimal operator-() const {
+        return fromParts(-m_mantissa, m_exponent);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const Decimal &value) {
+        return os << value.str();
+    }
+};
+
+/// Prices and balances, see Decimal for the range
+using Price = Decimal;
+
+/// Volumes and turnovers, see Decimal for the range
+using Quantity = Decimal;
+
+/// Funding rates, up to ~9.2e8
+using Rate = FixedDecimal<10>;
+}
+
+#endif // INCLUDE_VK_MEXC_FIXED_DECIMAL_H
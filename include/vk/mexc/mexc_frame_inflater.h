@@ -0,0 +1,48 @@
+/**
+MEXC Compressed Frame Inflater
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_FRAME_INFLATER_H
+#define INCLUDE_VK_MEXC_FRAME_INFLATER_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace vk::mexc {
+struct InflaterStats {
+    std::int64_t frames{};
+    std::int64_t compressedBytes{};
+    std::int64_t inflatedBytes{};
+};
+
+/**
+ * Decompresses WebSocket payloads sent with the compress flag. Gzip, zlib and raw deflate data are recognized by
+ * their headers. The inflate context and the output buffer are reused, after the first frames of the largest size
+ * decoding does not allocate. Not thread-safe, each session has its own inflater.
+ */
+class FrameInflater {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    FrameInflater();
+
+    ~FrameInflater();
+
+    /**
+     * @param payload compressed frame
+     * @return decompressed frame, valid until the next call
+     * @throws std::runtime_error if the payload is corrupted or truncated
+     */
+    std::string_view inflate(std::string_view payload);
+
+    [[nodiscard]] InflaterStats stats() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_FRAME_INFLATER_H
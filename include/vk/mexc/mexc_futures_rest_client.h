@@ -16,6 +16,10 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include "mexc_models.h"
 #include "mexc_enums.h"
 #include "mexc_http_futures_session.h"
+#include "mexc_retry_policy.h"
+#include "mexc_candle_columns.h"
+#include "mexc_contract_details_view.h"
+#include "mexc_contract_index.h"
 
 namespace vk::mexc::futures {
 
@@ -45,6 +49,25 @@ public:
 	*/
 	[[nodiscard]] std::int64_t getServerTime() const;
 
+	/**
+	 * Estimate offset of the server clock NTP-style from several server time round trips, signed requests are
+	 * timestamped with the corrected time afterward. Call it periodically to follow the drift of the local clock.
+	 * @param samples number of round trips
+	 * @return estimated server time minus local time in ms
+	 */
+	std::int64_t synchronizeClock(int samples = 5) const;
+
+	/**
+	 * @return clock estimate used to timestamp signed requests
+	 */
+	[[nodiscard]] const ClockSync &clockSync() const;
+
+	/**
+	 * Set time in ms after the request timestamp the signed requests are valid for, default is 25000
+	 * @param receiveWindow window in ms, MEXC accepts at most 60000
+	 */
+	void setReceiveWindow(int receiveWindow) const;
+
 	/**
 	 * Returns contract details for all contracts (or a specific one)
 	 * @param symbol optional contract name (returns all if empty)
@@ -53,6 +76,23 @@ public:
 	 */
 	[[nodiscard]] std::vector<ContractDetail> getContractDetails(const std::string &symbol = "") const;
 
+	/**
+	 * Returns contract details scanned from the response text into the arena of result, see PmrContractDetails
+	 * @param result previous contents are released, a reused object parses a response of the same size without
+	 * allocating from its upstream resource
+	 * @param symbol optional contract name (returns all if empty)
+	 * @see https://www.mexc.com/api-docs/futures/market-endpoints#get-contract-info
+	 */
+	void getContractDetails(PmrContractDetails &result, const std::string &symbol = "") const;
+
+	/**
+	 * Returns contract details decoded lazily, fields are parsed only when they are accessed
+	 * @param symbol optional contract name (returns all if empty)
+	 * @return ContractDetailsView
+	 * @see https://www.mexc.com/api-docs/futures/market-endpoints#get-contract-info
+	 */
+	[[nodiscard]] ContractDetailsView getContractDetailsView(const std::string &symbol = "") const;
+
 	/**
 	 * Returns contract funding rate
 	 * @return FundingRate
@@ -95,6 +135,15 @@ public:
 	 */
 	[[nodiscard]] Ticker getContractTicker(const std::string &symbol) const;
 
+	/**
+	 * Returns snapshot of the contract order book, asks ascending and bids descending by price
+	 * @param symbol contract symbol (e.g., BTC_USDT)
+	 * @param limit number of levels per side, 0 for the full book
+	 * @return Depth with the version the incremental updates of sub.depth continue from
+	 * @see https://mexcdevelop.github.io/apidocs/contract_v1_en/#get-the-contract-s-depth-information
+	 */
+	[[nodiscard]] Depth getContractDepth(const std::string &symbol, std::int32_t limit = 0) const;
+
 	/**
 	 * Returns current open positions (requires authentication)
 	 * @param symbol optional filter by symbol (empty = all positions)
@@ -112,13 +161,48 @@ public:
 	[[nodiscard]] OrderResponse submitOrder(const OrderRequest &request) const;
 
 	/**
-	 * Cancel futures orders by ID (requires WEB token auth)
-	 * @param orderIds list of order IDs to cancel (max 50)
-	 * @return CancelOrderResponse with per-order results
+	 * Set index used to validate orders before they are sent, invalid orders are rejected locally. It has to be set
+	 * before orders are submitted from other threads.
+	 * @param contractIndex e.g. std::make_shared<ContractIndex>(getContractDetails()), nullptr disables validation
+	 */
+	void setContractIndex(const std::shared_ptr<const ContractIndex> &contractIndex) const;
+
+	/**
+	 * Submit futures orders in batches (requires WEB token auth). Requests are split into chunks of 50 orders which
+	 * are sent concurrently, a failed chunk does not throw, its orders are reported with an error code instead.
+	 * Orders rejected by the contract index are not sent, they are reported after the others with error code -2.
+	 * @param requests Order parameters
+	 * @return BatchOrderResponse with merged per-order results, success is false if any chunk failed
+	 * @see https://mexcdevelop.github.io/apidocs/contract_v1_en/#bulk-order-under-maintenance
+	 */
+	[[nodiscard]] BatchOrderResponse submitOrders(const std::vector<OrderRequest> &requests) const;
+
+	/**
+	 * Cancel futures orders by ID (requires WEB token auth). IDs are split into chunks of 50 (API limit) which are
+	 * sent concurrently, a failed chunk does not throw, its orders are reported with an error code instead.
+	 * @param orderIds list of order IDs to cancel
+	 * @return CancelOrderResponse with merged per-order results, success is false if any chunk failed
 	 * @see https://mexcdevelop.github.io/apidocs/contract_v1_en/#cancel-the-order-under-maintenance
 	 */
 	[[nodiscard]] CancelOrderResponse cancelOrders(const std::vector<std::int64_t> &orderIds) const;
 
+	/**
+	 * Returns number of public requests which were not sent because an identical request was already in flight
+	 * @return count of coalesced requests
+	 */
+	[[nodiscard]] std::int64_t coalescedRequestsCount() const;
+
+	/**
+	 * Configure retrying of public GET requests and the per-endpoint circuit breakers
+	 * @param settings
+	 */
+	void setRetrySettings(const RetrySettings &settings) const;
+
+	/**
+	 * @return retry and circuit breaker counters of public GET requests
+	 */
+	[[nodiscard]] RetryStats retryStats() const;
+
 	/**
 	 * Download historical candles
 	 * @param symbol e.g. BTC_USDT
@@ -133,6 +217,21 @@ public:
 	[[nodiscard]] std::vector<Candle>
 	getHistoricalPrices(const std::string &symbol, CandleInterval interval, std::int64_t startTime,
 	                    std::int64_t endTime, const onCandlesDownloaded &writer = {}) const;
+
+	/**
+	 * Download historical candles into columns, the kline arrays of the response are copied directly without
+	 * building Candle rows
+	 * @param symbol e.g. BTC_USDT
+	 * @param interval candle interval
+	 * @param startTime timestamp in seconds
+	 * @param endTime timestamp in seconds
+	 * @return candles in chronological order, openTime in ms
+	 * @throws std::exception
+	 * @see https://www.mexc.com/api-docs/futures/market-endpoints#get-contract-kline
+	 */
+	[[nodiscard]] CandleColumns
+	getHistoricalCandleColumns(const std::string &symbol, CandleInterval interval, std::int64_t startTime,
+	                           std::int64_t endTime) const;
 };
 }
 
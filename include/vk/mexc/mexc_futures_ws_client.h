@@ -9,13 +9,58 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #ifndef INCLUDE_VK_MEXC_FUTURES_WS_CLIENT_H
 #define INCLUDE_VK_MEXC_FUTURES_WS_CLIENT_H
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "vk/utils/log_utils.h"
 #include "vk/utils/utils.h"
+#include "mexc_event_queue.h"
 #include "mexc_futures_ws_session.h"
 
 namespace vk::mexc::futures {
+struct ReconnectSettings {
+    std::chrono::milliseconds initialBackoff{250};
+    /// Upper bound of the delay between two connection attempts
+    std::chrono::milliseconds maxBackoff{30000};
+    double backoffMultiplier = 2.0;
+    /// Interval of the WebSocket pings
+    std::chrono::milliseconds pingInterval{20000};
+    /// A connection whose pongs stop coming is closed after this many unanswered pings in a row and reconnected
+    int maxMissedPongs{2};
+};
+
+/**
+ * Outage of the stream, events published within the window were not received
+ */
+struct StreamGap {
+    std::chrono::system_clock::time_point from{}; ///< last frame received before the connection was lost
+    std::chrono::system_clock::time_point to{};   ///< first frame received after the reconnection
+    int attempts{};                               ///< connection attempts until the stream recovered
+    std::size_t connection{};                     ///< index of the connection, see WSClient::connectionLoads
+    std::vector<nlohmann::json> subscriptions;    ///< subscription requests of the connection
+};
+
+struct ShardingSettings {
+    /// Connections the subscriptions are spread over, more are opened when all of them are full
+    std::size_t connections{1};
+    /// Subscriptions per connection
+    std::size_t maxSubscriptionsPerConnection{100};
+    /// IO threads the connections are distributed over round-robin, applies to the connections opened later
+    std::size_t ioThreads{1};
+};
+
+using onStreamGap = std::function<void(const StreamGap &streamGap)>;
+/// The gap is still open, StreamGap::to is not set
+using onConnectionLost = std::function<void(const StreamGap &streamGap)>;
+
+/**
+ * Futures WebSocket client. Subscriptions are sharded across connections according to ShardingSettings, each new
+ * subscription goes to the least loaded connection. When a connection is lost it reconnects with exponential backoff
+ * and jitter and replays all subscriptions of the connection, the outage is reported by the Stream Gap callback.
+ * With more IO threads the callbacks are called from several threads concurrently.
+ */
 class WSClient : public noncopyable {
     struct P;
     std::unique_ptr<P> m_p{};
@@ -42,6 +87,132 @@ public:
      */
     void setDataEventCallback(const onDataEvent &onDataEventCB) const;
 
+    /**
+     * Add queue receiving each Data Message event, so the consumer handles the events on its own thread and a slow
+     * consumer does not stall the IO thread. Each consumer gets its own queue, the last added one gets the event
+     * moved into it and the others a copy. The queues are closed when the client is destroyed. It can be called at
+     * any time, the queue receives the events delivered after it. The frames of the channels with a typed callback,
+     * a typed queue or a channel handler are not Data Message events and never reach these queues.
+     * @param settings capacity and overflow policy
+     * @return queue to poll
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue<Event>> addEventQueue(const EventQueueSettings &settings = {}) const;
+
+    /**
+     * Add queue receiving the push.ticker events decoded without a JSON DOM, next to the ticker callback if set.
+     * The last added queue gets the event moved into it. Must be called before the first subscription.
+     * @param settings capacity and overflow policy
+     * @return queue to poll
+     * @throws std::runtime_error if called after the first subscription
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue<EventTicker>>
+    addEventTickerQueue(const EventQueueSettings &settings = {}) const;
+
+    /**
+     * Add queue receiving the push.kline events, see addEventTickerQueue
+     * @param settings capacity and overflow policy
+     * @return queue to poll
+     * @throws std::runtime_error if called after the first subscription
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue<EventCandlestick>>
+    addEventCandlestickQueue(const EventQueueSettings &settings = {}) const;
+
+    /**
+     * Add queue receiving the push.depth updates and push.depth.full snapshots, see addEventTickerQueue
+     * @param settings capacity and overflow policy
+     * @return queue to poll
+     * @throws std::runtime_error if called after the first subscription
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue<EventDepth>>
+    addEventDepthQueue(const EventQueueSettings &settings = {}) const;
+
+    /**
+     * Set push.ticker callback, the ticker frames are decoded without a JSON DOM and not passed to the Data Message
+     * callback. Must be set before the first subscription.
+     * @param onEventTickerCB
+     * @throws std::runtime_error if called after the first subscription
+     */
+    void setEventTickerCallback(const onEventTicker &onEventTickerCB) const;
+
+    /**
+     * Set push.kline callback, the candlestick frames are decoded without a JSON DOM and not passed to the Data
+     * Message callback. Must be set before the first subscription.
+     * @param onEventCandlestickCB
+     * @throws std::runtime_error if called after the first subscription
+     */
+    void setEventCandlestickCallback(const onEventCandlestick &onEventCandlestickCB) const;
+
+    /**
+     * Set push.depth and push.depth.full callback, the depth frames are decoded without a JSON DOM and not passed to
+     * the Data Message callback. Must be set before the first subscription.
+     * @param onEventDepthCB
+     * @throws std::runtime_error if called after the first subscription
+     */
+    void setEventDepthCallback(const onEventDepth &onEventDepthCB) const;
+
+    /**
+     * Set handler of a push channel, the frames of the channel are passed to it without a JSON DOM and not passed
+     * to the Data Message callback. Must be set before the first subscription.
+     * @param channel e.g. push.deal
+     * @param handler
+     * @throws std::runtime_error if called after the first subscription
+     */
+    void setChannelHandler(std::string_view channel, const onChannelFrame &handler) const;
+
+    /**
+     * Set Stream Gap callback, called from the IO thread when the stream recovers after a lost connection
+     * @param onStreamGapCB
+     */
+    void setStreamGapCallback(const onStreamGap &onStreamGapCB) const;
+
+    /**
+     * Set Connection Lost callback, called from the IO thread when a connection is lost, before the reconnection.
+     * The events of its subscriptions stop until the Stream Gap callback reports the recovery.
+     * @param onConnectionLostCB
+     */
+    void setConnectionLostCallback(const onConnectionLost &onConnectionLostCB) const;
+
+    /**
+     * Set backoff of the reconnection and the ping settings, they apply to the connections opened later
+     * @param settings
+     */
+    void setReconnectSettings(const ReconnectSettings &settings) const;
+
+    /**
+     * Set host and port of the WebSocket endpoint, e.g. of a proxy or a test server, the connections opened later
+     * use it. The default is contract.mexc.com:443.
+     * @param host
+     * @param port
+     */
+    void setEndpoint(const std::string &host, const std::string &port) const;
+
+    /**
+     * Negotiate the permessage-deflate extension on the connections opened later, the server may decline it.
+     * Independent of it, pushes of the subscriptions with WSSubscriptionParameters::compress are always decoded.
+     * @param enable
+     */
+    void setPermessageDeflate(bool enable) const;
+
+    /**
+     * Set sharding of the subscriptions, the existing subscriptions are rebalanced
+     * @param settings
+     */
+    void setShardingSettings(const ShardingSettings &settings) const;
+
+    [[nodiscard]] ShardingSettings shardingSettings() const;
+
+    /**
+     * Move subscriptions from the overloaded connections to the least loaded ones, so no connection has more than
+     * its fair share, i.e. the subscriptions divided by the connections rounded up, and none exceeds the cap. Moved
+     * streams are unsubscribed on the old connection.
+     */
+    void rebalance() const;
+
+    /**
+     * @return number of subscriptions assigned to each connection
+     */
+    [[nodiscard]] std::vector<std::size_t> connectionLoads() const;
+
     /**
      * Subscribe WebSocket according to the subscriptionRequest
      * @param subscriptionRequest
@@ -11,17 +11,30 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 
 #include "vk/utils/log_utils.h"
 #include "vk/mexc/mexc_event_models.h"
+#include "vk/mexc/mexc_channel_registry.h"
+#include "vk/mexc/mexc_frame_inflater.h"
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl/context.hpp>
+#include <chrono>
 #include <memory>
 
 namespace vk::mexc::futures {
 using onDataEvent = std::function<void(const Event& event)>;
+/// Data Message callback of the session, the event is not used after it and may be moved from
+using onSessionDataEvent = std::function<void(Event&& event)>;
+using onEventTicker = std::function<void(const EventTicker& eventTicker)>;
+using onEventCandlestick = std::function<void(const EventCandlestick& eventCandlestick)>;
+using onEventDepth = std::function<void(const EventDepth& eventDepth)>;
+using onSessionClosed = std::function<void()>;
+using onSessionOpened = std::function<void()>;
 
 class WebSocketSession final : public std::enable_shared_from_this<WebSocketSession> {
     struct P;
     std::unique_ptr<P> m_p;
 
+    /// Send the pending requests on the strand of the session
+    void flush() const;
+
 public:
     explicit WebSocketSession(boost::asio::io_context& ioc, boost::asio::ssl::context& ctx,
                               const onLogMessage& onLogMessageCB);
@@ -36,7 +49,50 @@ public:
      * @param dataEventCB Data Message callback
      */
     void run(const std::string& host, const std::string& port, const nlohmann::json &subscriptionRequest,
-             const onDataEvent& dataEventCB);
+             const onSessionDataEvent& dataEventCB);
+
+    /**
+     * Set handlers of the push channels, must be called before run. Frames of a registered channel are passed to its
+     * handler without a JSON DOM and are not passed to the Data Message callback.
+     * @param channelRegistry
+     */
+    void setChannelRegistry(const ChannelRegistry& channelRegistry) const;
+
+    /**
+     * Negotiate the permessage-deflate extension, the server may decline it, must be called before run
+     * @param enable
+     */
+    void setPermessageDeflate(bool enable) const;
+
+    /**
+     * Set the ping interval and the number of unanswered pings in a row after which the connection is considered
+     * dead, it is closed then and the session closed callback runs. Must be called before run.
+     * @param interval
+     * @param maxMissedPongs
+     */
+    void setPingSettings(std::chrono::milliseconds interval, int maxMissedPongs) const;
+
+    /**
+     * @return statistics of the compressed frames, i.e. of the subscriptions with the compress flag
+     */
+    [[nodiscard]] InflaterStats inflaterStats() const;
+
+    /**
+     * Set callback called once when the session ends, either by an error or by closing, must be called before run
+     * @param sessionClosedCB
+     */
+    void setSessionClosedCallback(const onSessionClosed& sessionClosedCB) const;
+
+    /**
+     * Set callback called once when the first frame of the session is received, must be called before run
+     * @param sessionOpenedCB
+     */
+    void setSessionOpenedCallback(const onSessionOpened& sessionOpenedCB) const;
+
+    /**
+     * @return time of the last received frame, default constructed if nothing was received
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point lastReceiveTime() const;
 
     /**
      * Close the session asynchronously
@@ -44,12 +100,20 @@ public:
     void close() const;
 
     /**
-     * Subscribe WebSocket according to the subscriptionFilter
+     * Subscribe WebSocket according to the subscriptionFilter. Requests are written back-to-back without waiting
+     * for the acknowledgements of the previous ones, these are matched by method in the order of sending. rs.error
+     * names no request, it is matched to the oldest request which is not acknowledged yet.
      * @param subscriptionRequest
      * @see https://mexcdevelop.github.io/apidocs/contract_v1_en/#public-channels
      */
     void subscribe(const nlohmann::json &subscriptionRequest) const;
 
+    /**
+     * Unsubscribe a stream, the unsub request is sent with the parameters of the subscription request
+     * @param subscriptionRequest the request the stream was subscribed with, e.g. sub.ticker
+     */
+    void unsubscribe(const nlohmann::json &subscriptionRequest) const;
+
     /**
      * Check if a stream is already subscribed
      * @param subscriptionRequest
@@ -9,6 +9,7 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #ifndef INCLUDE_VK_MEXC_HTTP_FUTURES_SESSION_H
 #define INCLUDE_VK_MEXC_HTTP_FUTURES_SESSION_H
 
+#include "mexc_clock_sync.h"
 #include <boost/asio/connect.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
@@ -41,6 +42,24 @@ public:
 
     ~HTTPSession();
 
+    /**
+     * Timestamp signed requests with the synchronized server clock instead of the local one
+     * @param clockSync shared clock estimate, nullptr for the local clock
+     */
+    void setClockSync(const std::shared_ptr<ClockSync> &clockSync) const;
+
+    /**
+     * Set time in ms after the request timestamp the signed request is valid for, sent in the Recv-Window header
+     * @param receiveWindow window in ms
+     */
+    void setReceiveWindow(int receiveWindow) const;
+
+    /**
+     * Public GET request which reports local time in ms right before the request is written and right after the
+     * response is read, the connection setup is not included
+     */
+    [[nodiscard]] http::response<http::string_body> methodGetTimed(const std::string &path, std::int64_t &requestTime, std::int64_t &responseTime) const;
+
     [[nodiscard]] http::response<http::string_body> methodGet(const std::string &path, const std::map<std::string, std::string> &parameters, bool isPublic = true) const;
 
     [[nodiscard]] http::response<http::string_body> methodPost(const std::string &path, const std::string &jsonBody) const;
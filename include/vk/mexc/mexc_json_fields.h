@@ -0,0 +1,283 @@
+/**
+MEXC JSON Field Binding
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_JSON_FIELDS_H
+#define INCLUDE_VK_MEXC_JSON_FIELDS_H
+
+#include "mexc_fixed_decimal.h"
+#include "mexc_json_scanner.h"
+#include "vk/utils/magic_enum_wrapper.hpp"
+#include <nlohmann/json.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace vk::mexc {
+
+namespace detail {
+constexpr std::uint32_t fnv1a(const std::string_view text, const std::uint32_t seed) {
+    std::uint32_t hash = 2166136261u ^ seed;
+
+    for (const char c: text) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/// MurmurHash3 finalizer, spreads the differences of short keys to all bits
+constexpr std::uint32_t mix(std::uint32_t hash) {
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+template<typename T>
+struct MemberPointerTraits;
+
+template<typename C, typename M>
+struct MemberPointerTraits<M C::*> {
+    using Class = C;
+    using Member = M;
+};
+
+template<typename T>
+struct IsDecimal : std::false_type {
+};
+
+template<int Scale>
+struct IsDecimal<FixedDecimal<Scale>> : std::true_type {
+};
+
+template<>
+struct IsDecimal<Decimal> : std::true_type {
+};
+
+/// Decimals and enums are accepted both as strings and numbers, other types are converted by nlohmann::json
+template<typename M>
+void readJsonValue(const nlohmann::json &value, M &target) {
+    if constexpr (IsDecimal<M>::value) {
+        if (value.is_string()) {
+            target.assign(value.get_ref<const std::string &>());
+        } else if (value.is_number()) {
+            target.assign(value.get<double>());
+        }
+    } else if constexpr (std::is_enum_v<M>) {
+        if (value.is_string()) {
+            if (const auto result = magic_enum::enum_cast<M>(value.get_ref<const std::string &>())) {
+                target = *result;
+            }
+        } else if (value.is_number_integer()) {
+            target = static_cast<M>(value.get<std::underlying_type_t<M>>());
+        }
+    } else if constexpr (std::is_same_v<M, std::pmr::string>) {
+        if (value.is_string()) {
+            target.assign(value.get_ref<const std::string &>());
+        }
+    } else if constexpr (std::is_same_v<M, std::vector<std::string>> ||
+                         std::is_same_v<M, std::pmr::vector<std::pmr::string>>) {
+        target.clear();
+
+        if (value.is_array()) {
+            for (const auto &item: value) {
+                if (item.is_string()) {
+                    target.emplace_back(item.get_ref<const std::string &>());
+                }
+            }
+        }
+    } else if constexpr (std::is_same_v<M, nlohmann::json>) {
+        target = value;
+    } else {
+        value.get_to(target);
+    }
+}
+
+/// Same conversions as readJsonValue, straight from the text without a DOM
+template<typename M>
+void scanJsonValue(JsonScanner &scanner, M &target) {
+    if constexpr (IsDecimal<M>::value) {
+        target.assign(scanner.readToken());
+    } else if constexpr (std::is_enum_v<M>) {
+        if (scanner.peek() == '"') {
+            if (const auto result = magic_enum::enum_cast<M>(scanner.readString())) {
+                target = *result;
+            }
+        } else {
+            target = static_cast<M>(scanner.readInt());
+        }
+    } else if constexpr (std::is_same_v<M, std::string> || std::is_same_v<M, std::pmr::string>) {
+        JsonScanner::unescape(scanner.readString(), target);
+    } else if constexpr (std::is_same_v<M, std::vector<std::string>> ||
+                         std::is_same_v<M, std::pmr::vector<std::pmr::string>>) {
+        target.clear();
+        scanner.readArray([&] {
+            if (scanner.peek() == '"') {
+                JsonScanner::unescape(scanner.readString(), target.emplace_back());
+            } else {
+                scanner.skipValue();
+            }
+        });
+    } else if constexpr (std::is_same_v<M, bool>) {
+        target = scanner.readBool();
+    } else if constexpr (std::is_integral_v<M>) {
+        target = static_cast<M>(scanner.readInt());
+    } else if constexpr (std::is_floating_point_v<M>) {
+        target = static_cast<M>(scanner.readDouble());
+    } else if constexpr (std::is_same_v<M, nlohmann::json>) {
+        target = nlohmann::json::parse(scanner.skipValue());
+    } else {
+        nlohmann::json::parse(scanner.skipValue()).get_to(target);
+    }
+}
+}
+
+template<typename T>
+struct JsonField {
+    std::string_view name;
+    void (*read)(const nlohmann::json &value, T &target);
+    void (*scan)(JsonScanner &scanner, T &target);
+};
+
+/**
+ * Bind JSON key to a data member
+ * @tparam Member pointer to the data member, e.g. &Ticker::lastPrice
+ * @param name JSON key
+ */
+template<auto Member>
+constexpr auto jsonField(const std::string_view name) {
+    using Class = typename detail::MemberPointerTraits<decltype(Member)>::Class;
+    return JsonField<Class>{
+        name, [](const nlohmann::json &value, Class &target) {
+            detail::readJsonValue(value, target.*Member);
+        },
+        [](JsonScanner &scanner, Class &target) {
+            detail::scanJsonValue(scanner, target.*Member);
+        }
+    };
+}
+
+/**
+ * Bind JSON key to custom conversions, e.g. of an array of nested models. Both are required, so the field can be read
+ * from a DOM as well as scanned.
+ * @tparam T model
+ * @param name JSON key
+ * @param read converts the value of the DOM
+ * @param scan converts the value at the position of the scanner, it has to consume the value
+ */
+template<typename T>
+constexpr JsonField<T> customJsonField(const std::string_view name, decltype(JsonField<T>::read) read,
+                                       decltype(JsonField<T>::scan) scan) {
+    return JsonField<T>{name, read, scan};
+}
+
+/**
+ * Field table of a model. A perfect hash of the keys is found at compile time, reading makes one pass over the
+ * members of the JSON object and each key is dispatched with one hash and one string comparison. Keys which are
+ * not in the table and null values are skipped, the corresponding fields keep their values.
+ */
+template<typename T, std::size_t N>
+class JsonFieldTable {
+    static_assert(N > 0 && N < 0xFF, "JSON field table must have 1 - 254 fields");
+
+    static constexpr std::size_t SLOTS = std::bit_ceil(N * 2);
+    static constexpr int SLOT_BITS = std::countr_zero(SLOTS);
+    static constexpr std::uint8_t EMPTY = 0xFF;
+
+    std::array<JsonField<T>, N> m_fields;
+    std::uint32_t m_seed{};
+    std::array<std::uint8_t, SLOTS> m_slots{};
+
+    static constexpr std::size_t slotOf(const std::string_view key, const std::uint32_t seed) {
+        return detail::mix(detail::fnv1a(key, seed)) >> (32 - SLOT_BITS);
+    }
+
+public:
+    consteval explicit JsonFieldTable(const std::array<JsonField<T>, N> &fields) : m_fields(fields) {
+        for (std::uint32_t seed = 0; seed < 100000; ++seed) {
+            bool isPerfect = true;
+            m_slots.fill(EMPTY);
+
+            for (std::size_t i = 0; i < N && isPerfect; ++i) {
+                if (auto &slot = m_slots[slotOf(m_fields[i].name, seed)]; slot == EMPTY) {
+                    slot = static_cast<std::uint8_t>(i);
+                } else {
+                    isPerfect = false;
+                }
+            }
+
+            if (isPerfect) {
+                m_seed = seed;
+                return;
+            }
+        }
+
+        throw std::logic_error("No perfect hash found for the JSON field table");
+    }
+
+    void read(const nlohmann::json &object, T &target) const {
+        if (!object.is_object()) {
+            return;
+        }
+
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            if (it->is_null()) {
+                continue;
+            }
+
+            const auto &key = it.key();
+
+            if (const auto index = m_slots[slotOf(key, m_seed)];
+                index != EMPTY && m_fields[index].name == key) {
+                m_fields[index].read(*it, target);
+            }
+        }
+    }
+
+    /**
+     * Read the object at the position of the scanner without building a DOM, the same rules as read() apply
+     * @param scanner positioned at the object, it is positioned after the object on return
+     * @param target
+     */
+    void scan(JsonScanner &scanner, T &target) const {
+        if (scanner.peek() != '{') {
+            scanner.skipValue();
+            return;
+        }
+
+        scanner.readObject([&](const std::string_view key) {
+            if (scanner.readNull()) {
+                return;
+            }
+
+            if (const auto index = m_slots[slotOf(key, m_seed)];
+                index != EMPTY && m_fields[index].name == key) {
+                m_fields[index].scan(scanner, target);
+            } else {
+                scanner.skipValue();
+            }
+        });
+    }
+};
+
+template<typename T, typename... Fields>
+consteval auto makeJsonFieldTable(const Fields &... fields) {
+    return JsonFieldTable<T, sizeof...(Fields)>(std::array<JsonField<T>, sizeof...(Fields)>{fields...});
+}
+}
+
+#endif // INCLUDE_VK_MEXC_JSON_FIELDS_H
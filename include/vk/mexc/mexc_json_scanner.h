@@ -0,0 +1,347 @@
+/**
+MEXC JSON Scanner
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_JSON_SCANNER_H
+#define INCLUDE_VK_MEXC_JSON_SCANNER_H
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace vk::mexc {
+/**
+ * Minimal forward-only JSON scanner which does not build a DOM. Strings are returned as raw views into the original
+ * buffer (escape sequences are not decoded, see unescape), the buffer must outlive the scanner. Values which are not
+ * needed are skipped without being parsed.
+ */
+class JsonScanner {
+    std::string_view m_text;
+    std::size_t m_pos{};
+
+    [[noreturn]] void malformed(const char *expected) const {
+        throw std::runtime_error("Malformed JSON at offset " + std::to_string(m_pos) + ", expected " + expected);
+    }
+
+    [[nodiscard]] static bool isDelimiter(const char c) {
+        return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    template<typename String>
+    static void appendUtf8(String &out, const std::uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    static std::uint32_t readHex4(const std::string_view raw, const std::size_t pos) {
+        std::uint32_t value = 0;
+
+        if (pos + 4 > raw.size() ||
+            std::from_chars(raw.data() + pos, raw.data() + pos + 4, value, 16).ptr != raw.data() + pos + 4) {
+            throw std::runtime_error("Malformed JSON string escape");
+        }
+
+        return value;
+    }
+
+    template<typename T>
+    T parseNumber(const std::string_view token) {
+        T value{};
+
+        if (const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+            ec != std::errc() || ptr != token.data() + token.size()) {
+            malformed("number");
+        }
+
+        return value;
+    }
+
+public:
+    explicit JsonScanner(const std::string_view text, const std::size_t pos = 0) : m_text(text), m_pos(pos) {
+    }
+
+    /**
+     * @return offset of the next unread character in the buffer
+     */
+    [[nodiscard]] std::size_t position() const {
+        return m_pos;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_text.size() &&
+               (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+            ++m_pos;
+        }
+    }
+
+    /**
+     * @return next non-whitespace character, '\0' at the end of the buffer
+     */
+    [[nodiscard]] char peek() {
+        skipWhitespace();
+        return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+    }
+
+    /**
+     * Consume the character if it is the next non-whitespace one
+     * @return true if consumed
+     */
+    bool consume(const char c) {
+        if (peek() == c) {
+            ++m_pos;
+            return true;
+        }
+
+        return false;
+    }
+
+    void expect(const char c) {
+        if (!consume(c)) {
+            const char expected[] = {'\'', c, '\'', '\0'};
+            malformed(expected);
+        }
+    }
+
+    /**
+     * Read a string
+     * @return raw content between the quotes
+     */
+    std::string_view readString() {
+        expect('"');
+        const auto begin = m_pos;
+
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            m_pos += m_text[m_pos] == '\\' ? 2 : 1;
+        }
+
+        if (m_pos >= m_text.size()) {
+            malformed("end of string");
+        }
+
+        return m_text.substr(begin, m_pos++ - begin);
+    }
+
+    /**
+     * Read a number, a literal or a string without its quotes, it is how MEXC sends some numbers
+     * @return raw token
+     */
+    std::string_view readToken() {
+        if (peek() == '"') {
+            return readString();
+        }
+
+        const auto begin = m_pos;
+
+        while (m_pos < m_text.size() && !isDelimiter(m_text[m_pos])) {
+            ++m_pos;
+        }
+
+        if (m_pos == begin) {
+            malformed("value");
+        }
+
+        return m_text.substr(begin, m_pos - begin);
+    }
+
+    double readDouble() {
+        return parseNumber<double>(readToken());
+    }
+
+    std::int64_t readInt() {
+        return parseNumber<std::int64_t>(readToken());
+    }
+
+    bool readBool() {
+        const auto token = readToken();
+
+        if (token == "true") {
+            return true;
+        }
+
+        if (token != "false") {
+            malformed("boolean");
+        }
+
+        return false;
+    }
+
+    /**
+     * Consume null if it is the next value
+     * @return true if the value was null
+     */
+    bool readNull() {
+        if (peek() == 'n' && m_text.substr(m_pos, 4) == "null") {
+            m_pos += 4;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Skip any value including nested objects and arrays
+     * @return raw text of the skipped value
+     */
+    std::string_view skipValue() {
+        const auto first = peek();
+        const auto begin = m_pos;
+
+        if (first == '"') {
+            readString();
+        } else if (first == '{' || first == '[') {
+            std::size_t depth = 0;
+
+            do {
+                if (m_pos >= m_text.size()) {
+                    malformed("end of value");
+                }
+
+                if (const auto c = m_text[m_pos]; c == '"') {
+                    readString();
+                    continue;
+                } else if (c == '{' || c == '[') {
+                    ++depth;
+                } else if (c == '}' || c == ']') {
+                    --depth;
+                }
+
+                ++m_pos;
+            } while (depth > 0);
+        } else {
+            readToken();
+        }
+
+        return m_text.substr(begin, m_pos - begin);
+    }
+
+    /**
+     * Iterate members of an object
+     * @param onMember called with the raw key, it has to consume the value, e.g. by skipValue
+     */
+    template<typename Callback>
+    void readObject(Callback &&onMember) {
+        expect('{');
+
+        if (consume('}')) {
+            return;
+        }
+
+        do {
+            const auto key = readString();
+            expect(':');
+            onMember(key);
+        } while (consume(','));
+
+        expect('}');
+    }
+
+    /**
+     * Iterate elements of an array
+     * @param onElement called for each element, it has to consume the element
+     */
+    template<typename Callback>
+    void readArray(Callback &&onElement) {
+        expect('[');
+
+        if (consume(']')) {
+            return;
+        }
+
+        do {
+            onElement();
+        } while (consume(','));
+
+        expect(']');
+    }
+
+    /**
+     * Decode escape sequences of a raw string
+     * @param raw string returned by readString
+     * @return decoded UTF-8 string
+     */
+    static std::string unescape(const std::string_view raw) {
+        std::string retVal;
+        unescape(raw, retVal);
+        return retVal;
+    }
+
+    /**
+     * Decode escape sequences of a raw string into an existing string, its allocator is used, e.g. of a
+     * std::pmr::string, and no temporary is created
+     * @param raw string returned by readString
+     * @param retVal replaced by the decoded UTF-8 string
+     */
+    template<typename String>
+    static void unescape(const std::string_view raw, String &retVal) {
+        if (raw.find('\\') == std::string_view::npos) {
+            retVal.assign(raw.data(), raw.size());
+            return;
+        }
+
+        retVal.clear();
+        retVal.reserve(raw.size());
+
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] != '\\' || i + 1 >= raw.size()) {
+                retVal.push_back(raw[i]);
+                continue;
+            }
+
+            switch (const auto c = raw[++i]) {
+            case 'b':
+                retVal.push_back('\b');
+                break;
+            case 'f':
+                retVal.push_back('\f');
+                break;
+            case 'n':
+                retVal.push_back('\n');
+                break;
+            case 'r':
+                retVal.push_back('\r');
+                break;
+            case 't':
+                retVal.push_back('\t');
+                break;
+            case 'u': {
+                auto codePoint = readHex4(raw, i + 1);
+                i += 4;
+
+                if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 2 < raw.size() && raw[i + 1] == '\\' &&
+                    raw[i + 2] == 'u') {
+                    const auto low = readHex4(raw, i + 3);
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+
+                appendUtf8(retVal, codePoint);
+                break;
+            }
+            default:
+                retVal.push_back(c);
+            }
+        }
+    }
+};
+}
+
+#endif // INCLUDE_VK_MEXC_JSON_SCANNER_H
@@ -9,10 +9,14 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #ifndef INCLUDE_VK_MEXC_MODELS_H
 #define INCLUDE_VK_MEXC_MODELS_H
 
-#include <boost/multiprecision/cpp_dec_float.hpp>
 #include <nlohmann/json.hpp>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
 #include "vk/interface/i_json.h"
 #include "mexc_enums.h"
+#include "mexc_fixed_decimal.h"
+#include "mexc_json_scanner.h"
 
 namespace vk::mexc::spot {
 
@@ -37,12 +41,12 @@ struct ServerTime final : Response {
 struct Candle final : Response {
     std::int64_t openTime{};
     std::int64_t closeTime{};
-     boost::multiprecision::cpp_dec_float_50 open{};
-     boost::multiprecision::cpp_dec_float_50 high{};
-     boost::multiprecision::cpp_dec_float_50 low{};
-     boost::multiprecision::cpp_dec_float_50 close{};
-     boost::multiprecision::cpp_dec_float_50 volume{};
-     boost::multiprecision::cpp_dec_float_50 quoteAssetVolume{};
+    Price open{};
+    Price high{};
+    Price low{};
+    Price close{};
+    Quantity volume{};
+    Quantity quoteAssetVolume{};
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
@@ -51,7 +55,51 @@ struct Candle final : Response {
 
 struct TickerPrice final : Response {
     std::string symbol{};
-    boost::multiprecision::cpp_dec_float_50 price{};
+    Price price{};
+
+    [[nodiscard]] nlohmann::json toJson() const override;
+
+    void fromJson(const nlohmann::json &json) override;
+};
+
+/**
+ * Prices of all symbols decoded into a flat table sorted by symbol, symbols[i] belongs to prices[i]
+ */
+struct TickerPriceSnapshot final : Response {
+    struct Change {
+        std::size_t index{};     ///< Index of the symbol in this snapshot
+        double previousPrice{};
+        double price{};
+    };
+
+    struct Diff {
+        std::vector<Change> changed{};
+        std::vector<std::size_t> added{};    ///< Indexes into this snapshot
+        std::vector<std::string> removed{};
+    };
+
+    std::vector<std::string> symbols{};
+    std::vector<double> prices{};
+
+    /**
+     * Find symbol using binary search over the sorted symbols
+     * @param symbol e.g. BTCUSDT
+     * @return index into symbols and prices if found
+     */
+    [[nodiscard]] std::optional<std::size_t> indexOf(std::string_view symbol) const;
+
+    /**
+     * @param symbol e.g. BTCUSDT
+     * @return price of the symbol if found
+     */
+    [[nodiscard]] std::optional<double> price(std::string_view symbol) const;
+
+    /**
+     * Compare with the previous snapshot in one merge pass over both sorted tables
+     * @param previous older snapshot
+     * @return changed, added and removed symbols
+     */
+    [[nodiscard]] Diff diff(const TickerPriceSnapshot &previous) const;
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
@@ -98,9 +146,9 @@ struct ServerTime final : Response {
 
 struct FundingRate final : Response {
     std::string symbol{};
-    boost::multiprecision::cpp_dec_float_50 fundingRate{};
-    boost::multiprecision::cpp_dec_float_50 maxFundingRate{};
-    boost::multiprecision::cpp_dec_float_50 minFundingRate{};
+    Rate fundingRate{};
+    Rate maxFundingRate{};
+    Rate minFundingRate{};
     std::int32_t collectCycle{};
     std::int64_t nextSettleTime{};
     std::int64_t timestamp{};
@@ -108,6 +156,12 @@ struct FundingRate final : Response {
     [[nodiscard]] nlohmann::json toJson() const override;
 
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct FundingRates final : Response {
@@ -116,11 +170,17 @@ struct FundingRates final : Response {
     [[nodiscard]] nlohmann::json toJson() const override;
 
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct HistoricalFundingRate final : IJson {
     std::string symbol{};
-    boost::multiprecision::cpp_dec_float_50 fundingRate{};
+    Rate fundingRate{};
     std::int64_t settleTime{};
 
     [[nodiscard]] nlohmann::json toJson() const override;
@@ -142,13 +202,13 @@ struct HistoricalFundingRates final : Response {
 
 struct WalletBalance final : Response {
     std::string currency{};
-    boost::multiprecision::cpp_dec_float_50 positionMargin{};
-    boost::multiprecision::cpp_dec_float_50 availableBalance{};
-    boost::multiprecision::cpp_dec_float_50 cashBalance{};
-    boost::multiprecision::cpp_dec_float_50 frozenBalance{};
-    boost::multiprecision::cpp_dec_float_50 equity{};
-    boost::multiprecision::cpp_dec_float_50 unrealized{};
-    boost::multiprecision::cpp_dec_float_50 bonus{};
+    Price positionMargin{};
+    Price availableBalance{};
+    Price cashBalance{};
+    Price frozenBalance{};
+    Price equity{};
+    Price unrealized{};
+    Price bonus{};
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
@@ -157,17 +217,54 @@ struct WalletBalance final : Response {
 
 struct Ticker final : Response {
     std::string symbol{};
-    boost::multiprecision::cpp_dec_float_50 lastPrice{};
-    boost::multiprecision::cpp_dec_float_50 bid1{};
-    boost::multiprecision::cpp_dec_float_50 ask1{};
-    boost::multiprecision::cpp_dec_float_50 volume24{};
-    boost::multiprecision::cpp_dec_float_50 amount24{};
-    boost::multiprecision::cpp_dec_float_50 holdVol{};
+    Price lastPrice{};
+    Price bid1{};
+    Price ask1{};
+    Quantity volume24{};
+    Quantity amount24{};
+    Quantity holdVol{};
     std::int64_t timestamp{};
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
+};
+
+/// Price level of the order book, MEXC sends it as [price, volume, orderCount]
+struct DepthLevel {
+    Price price{};
+    Quantity volume{};         ///< contracts, 0 removes the level in the incremental updates
+    std::int32_t orderCount{};
+};
+
+/**
+ * Read array of [price, volume, orderCount] levels, the prices and volumes are parsed exactly from their tokens
+ * @param scanner positioned at the array
+ * @param levels replaced by the levels read
+ */
+void readDepthLevels(JsonScanner &scanner, std::vector<DepthLevel> &levels);
+
+struct Depth final : Response {
+    std::vector<DepthLevel> asks{};
+    std::vector<DepthLevel> bids{};
+    std::int64_t version{};
+    std::int64_t timestamp{};
+
+    [[nodiscard]] nlohmann::json toJson() const override;
+
+    void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct OpenPosition final : IJson {
@@ -176,15 +273,15 @@ struct OpenPosition final : IJson {
     std::int32_t positionType{};  ///< 1=long, 2=short
     std::int32_t openType{};      ///< 1=isolated, 2=cross
     std::int32_t state{};
-    boost::multiprecision::cpp_dec_float_50 holdVol{};
-    boost::multiprecision::cpp_dec_float_50 frozenVol{};
-    boost::multiprecision::cpp_dec_float_50 holdAvgPrice{};
-    boost::multiprecision::cpp_dec_float_50 openAvgPrice{};
-    boost::multiprecision::cpp_dec_float_50 liquidatePrice{};
-    boost::multiprecision::cpp_dec_float_50 oim{};
-    boost::multiprecision::cpp_dec_float_50 im{};
-    boost::multiprecision::cpp_dec_float_50 holdFee{};
-    boost::multiprecision::cpp_dec_float_50 realised{};
+    Quantity holdVol{};
+    Quantity frozenVol{};
+    Price holdAvgPrice{};
+    Price openAvgPrice{};
+    Price liquidatePrice{};
+    Price oim{};
+    Price im{};
+    Price holdFee{};
+    Price realised{};
     std::int32_t leverage{};
     std::int64_t createTime{};
     std::int64_t updateTime{};
@@ -192,6 +289,12 @@ struct OpenPosition final : IJson {
     [[nodiscard]] nlohmann::json toJson() const override;
 
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode one position straight from its text
+     * @param scanner positioned at the position object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct OpenPositions final : Response {
@@ -200,6 +303,12 @@ struct OpenPositions final : Response {
     [[nodiscard]] nlohmann::json toJson() const override;
 
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct OrderRequest final : IJson {
@@ -242,14 +351,29 @@ struct CancelOrderResponse final : Response {
     void fromJson(const nlohmann::json &json) override;
 };
 
+struct BatchOrderResponse final : Response {
+    struct Result {
+        std::int64_t orderId{};
+        std::string externalOid{};
+        std::int32_t errorCode{};
+        std::string errorMsg{};
+    };
+
+    std::vector<Result> results{};
+
+    [[nodiscard]] nlohmann::json toJson() const override;
+
+    void fromJson(const nlohmann::json &json) override;
+};
+
 struct Candle final : IJson {
     std::int64_t openTime{};
-    boost::multiprecision::cpp_dec_float_50 open{};
-    boost::multiprecision::cpp_dec_float_50 high{};
-    boost::multiprecision::cpp_dec_float_50 low{};
-    boost::multiprecision::cpp_dec_float_50 close{};
-    boost::multiprecision::cpp_dec_float_50 volume{};
-    boost::multiprecision::cpp_dec_float_50 amount{};
+    Price open{};
+    Price high{};
+    Price low{};
+    Price close{};
+    Quantity volume{};
+    Quantity amount{};
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
@@ -261,7 +385,17 @@ struct Candles final : Response {
 
     [[nodiscard]] nlohmann::json toJson() const override;
 
+    /**
+     * Compatibility path for an already parsed DOM, it dumps the DOM back to text and scans it.
+     * Slow, prefer fromJson(JsonScanner &) on the response text.
+     */
     void fromJson(const nlohmann::json &json) override;
+
+    /**
+     * Decode the response straight from its text, the prices and volumes are parsed exactly from their tokens
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
 };
 
 struct ContractDetail final : IJson {
@@ -277,7 +411,7 @@ struct ContractDetail final : IJson {
     std::int32_t minVol{1};
     std::int32_t maxVol{1000000};
     std::int32_t volUnit{1};
-    std::int32_t priceUnit{1};
+    double priceUnit{1.0};             ///< tick size, e.g. 0.1
     std::int32_t pricePrecision{2};
     std::int32_t volPrecision{0};
     std::vector<std::string> conceptPlate{};
@@ -294,6 +428,127 @@ struct ContractDetails final : Response {
 
     void fromJson(const nlohmann::json &json) override;
 };
+
+/**
+ * Allocator-aware ContractDetail, the strings and conceptPlate are allocated from the memory resource of the
+ * allocator, see PmrContractDetails
+ */
+struct PmrContractDetail {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    std::pmr::string symbol{};
+    std::pmr::string displayNameEn{};
+    std::pmr::string baseCoin{};
+    std::pmr::string quoteCoin{};
+    std::pmr::string settleCoin{};
+    ContractState state{ContractState::Enabled};
+    bool apiAllowed{true};
+    std::int32_t automaticDelivery{};
+    double contractSize{1.0};
+    std::int32_t minVol{1};
+    std::int32_t maxVol{1000000};
+    std::int32_t volUnit{1};
+    double priceUnit{1.0};             ///< tick size, e.g. 0.1
+    std::int32_t pricePrecision{2};
+    std::int32_t volPrecision{0};
+    std::pmr::vector<std::pmr::string> conceptPlate{};
+
+    explicit PmrContractDetail(const allocator_type &allocator = {});
+
+    PmrContractDetail(const PmrContractDetail &other, const allocator_type &allocator = {});
+
+    PmrContractDetail(PmrContractDetail &&other) noexcept = default;
+
+    PmrContractDetail(PmrContractDetail &&other, const allocator_type &allocator);
+
+    PmrContractDetail &operator=(const PmrContractDetail &other) = default;
+
+    PmrContractDetail &operator=(PmrContractDetail &&other) = default;
+
+    void fromJson(const nlohmann::json &json);
+
+    /**
+     * Decode one contract straight from its text, the strings are allocated from the allocator only
+     * @param scanner positioned at the contract object
+     */
+    void fromJson(JsonScanner &scanner);
+
+    /**
+     * @return copy allocated from the default heap
+     */
+    [[nodiscard]] ContractDetail toContractDetail() const;
+};
+
+/**
+ * ContractDetails response parsed into a monotonic arena. All strings of all contracts are carved from an owned
+ * initial buffer, blocks are taken from the upstream resource only when a response does not fit in it. Nothing is
+ * freed until the next fromJson or the destruction, which release the whole arena at once. The blocks go back to
+ * the upstream then and the initial buffer grows to the high-water mark, so a reused object parses responses of
+ * the same size without any upstream allocation.
+ * It is neither copyable nor movable because the details point into its arena.
+ */
+class PmrContractDetails {
+    /// Forwards to the upstream resource and counts the bytes the arena takes beyond its initial buffer
+    class UpstreamCounter final : public std::pmr::memory_resource {
+        std::pmr::memory_resource *m_upstream;
+
+    public:
+        std::size_t allocated{};
+
+        explicit UpstreamCounter(std::pmr::memory_resource *upstream) : m_upstream(upstream) {
+        }
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+
+        [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override;
+    };
+
+    UpstreamCounter m_upstream;
+    std::pmr::vector<std::byte> m_buffer;
+    std::optional<std::pmr::monotonic_buffer_resource> m_arena;
+
+public:
+    int code{};
+    bool success{};
+    std::pmr::vector<PmrContractDetail> contractDetails;
+
+    /**
+     * @param initialSize size of the initial arena buffer in bytes, it is allocated from upstream right away
+     * @param upstream resource the initial buffer and the overflow blocks are allocated from
+     */
+    explicit PmrContractDetails(std::size_t initialSize = 256 * 1024,
+                                std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+    PmrContractDetails(const PmrContractDetails &) = delete;
+
+    PmrContractDetails &operator=(const PmrContractDetails &) = delete;
+
+    /**
+     * Drop all details and release the arena, the initial buffer grows to the size used since the last clear
+     */
+    void clear();
+
+    /**
+     * @return size of the initial arena buffer in bytes
+     */
+    [[nodiscard]] std::size_t bufferSize() const {
+        return m_buffer.size();
+    }
+
+    /**
+     * Read the details from a parsed document, the DOM itself is allocated from the default heap
+     */
+    void fromJson(const nlohmann::json &json);
+
+    /**
+     * Decode the response straight from its text into the arena, used by RESTClient::getContractDetails
+     * @param scanner positioned at the response object
+     */
+    void fromJson(JsonScanner &scanner);
+};
 }
 
 #endif // INCLUDE_VK_MEXC_MODELS_H
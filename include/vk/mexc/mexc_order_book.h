@@ -0,0 +1,101 @@
+/**
+MEXC Order Book
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_ORDER_BOOK_H
+#define INCLUDE_VK_MEXC_ORDER_BOOK_H
+
+#include "mexc_event_models.h"
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace vk::mexc::futures {
+enum class BookUpdate : std::int32_t {
+    Applied,  ///< applied, or ignored because the book already contains it
+    Buffered, ///< the book waits for a snapshot, the update is replayed on top of it
+    Gap       ///< the version does not follow the last one, the book waits for a snapshot now
+};
+
+/// Best levels of both sides, a side without levels has zero price and volume
+struct BookTop {
+    DepthLevel bid{};
+    DepthLevel ask{};
+    std::int64_t version{};
+    std::int64_t ts{};
+};
+
+/// Best levels of both sides, bids[0] and asks[0] are the best ones
+struct BookDepth {
+    std::vector<DepthLevel> bids{};
+    std::vector<DepthLevel> asks{};
+    std::int64_t version{};
+    std::int64_t ts{};
+};
+
+/**
+ * Local order book of one contract maintained from a snapshot and the incremental updates of sub.depth. Each side
+ * is a flat array sorted so the best level is at the back, the updates hitting the top of the book do not shift
+ * the array. A version which does not follow the previous one marks the book out of sync, the following updates are
+ * buffered until applySnapshot replays them on top of a fresh snapshot.
+ *
+ * The writers are serialized by a mutex. After each change the top levels are published through a sequence lock,
+ * top() and depth() read them without locking and retry only when they overlap a write.
+ */
+class OrderBook {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    /**
+     * @param publishedLevels levels per side readable by depth()
+     */
+    explicit OrderBook(std::size_t publishedLevels = 20);
+
+    ~OrderBook();
+
+    OrderBook(const OrderBook &) = delete;
+
+    OrderBook &operator=(const OrderBook &) = delete;
+
+    /**
+     * Apply incremental update, levels with zero volume are removed
+     * @param update event of push.depth
+     * @return BookUpdate::Gap once when the book gets out of sync, the caller should request a snapshot
+     */
+    BookUpdate apply(const EventDepth &update) const;
+
+    /**
+     * Replace both sides by the snapshot and replay the buffered updates newer than it
+     * @param snapshot e.g. from RESTClient::getContractDepth or push.depth.full
+     * @return true if the book is in sync, false if the buffered updates do not continue from the snapshot
+     */
+    bool applySnapshot(const EventDepth &snapshot) const;
+
+    /**
+     * Mark the book out of sync, e.g. when the stream was interrupted
+     */
+    void invalidate() const;
+
+    [[nodiscard]] bool isSynced() const;
+
+    /**
+     * @return best bid and ask, std::nullopt if the book is not in sync
+     */
+    [[nodiscard]] std::optional<BookTop> top() const;
+
+    /**
+     * @param levels per side, at most publishedLevels
+     * @return best levels, std::nullopt if the book is not in sync
+     */
+    [[nodiscard]] std::optional<BookDepth> depth(std::size_t levels) const;
+
+    [[nodiscard]] std::size_t publishedLevels() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_ORDER_BOOK_H
@@ -0,0 +1,142 @@
+/**
+MEXC Protobuf Reader
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_PROTOBUF_READER_H
+#define INCLUDE_VK_MEXC_PROTOBUF_READER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace vk::mexc {
+/**
+ * Minimal reader of the protobuf wire format. Nothing is copied, length-delimited fields (strings, bytes and nested
+ * messages) are returned as views into the original buffer which must outlive the reader.
+ * @see https://protobuf.dev/programming-guides/encoding/
+ */
+class ProtobufReader {
+public:
+    enum class WireType : std::uint32_t {
+        Varint = 0,
+        Fixed64 = 1,
+        LengthDelimited = 2,
+        Fixed32 = 5
+    };
+
+private:
+    const char *m_pos{};
+    const char *m_end{};
+    std::uint32_t m_fieldNumber{};
+    WireType m_wireType{WireType::Varint};
+
+    [[noreturn]] static void malformed() {
+        throw std::runtime_error("Malformed protobuf message");
+    }
+
+    void advance(const std::size_t count) {
+        if (static_cast<std::size_t>(m_end - m_pos) < count) {
+            malformed();
+        }
+        m_pos += count;
+    }
+
+public:
+    explicit ProtobufReader(const std::string_view buffer) : m_pos(buffer.data()), m_end(buffer.data() + buffer.size()) {
+    }
+
+    /**
+     * Read the next field tag
+     * @return false when the end of the message is reached
+     */
+    bool next() {
+        if (m_pos >= m_end) {
+            return false;
+        }
+
+        const auto tag = readVarint();
+        m_fieldNumber = static_cast<std::uint32_t>(tag >> 3);
+        m_wireType = static_cast<WireType>(tag & 0x07);
+        return true;
+    }
+
+    [[nodiscard]] std::uint32_t fieldNumber() const {
+        return m_fieldNumber;
+    }
+
+    [[nodiscard]] WireType wireType() const {
+        return m_wireType;
+    }
+
+    std::uint64_t readVarint() {
+        std::uint64_t value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_end) {
+                malformed();
+            }
+
+            const auto byte = static_cast<std::uint8_t>(*m_pos++);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        malformed();
+    }
+
+    std::int64_t readInt64() {
+        return static_cast<std::int64_t>(readVarint());
+    }
+
+    std::int32_t readInt32() {
+        return static_cast<std::int32_t>(readVarint());
+    }
+
+    bool readBool() {
+        return readVarint() != 0;
+    }
+
+    std::string_view readBytes() {
+        const auto length = readVarint();
+
+        if (length > static_cast<std::uint64_t>(m_end - m_pos)) {
+            malformed();
+        }
+
+        const std::string_view retVal(m_pos, static_cast<std::size_t>(length));
+        m_pos += length;
+        return retVal;
+    }
+
+    /**
+     * Skip value of the current field
+     */
+    void skip() {
+        switch (m_wireType) {
+        case WireType::Varint:
+            readVarint();
+            break;
+        case WireType::Fixed64:
+            advance(8);
+            break;
+        case WireType::LengthDelimited:
+            readBytes();
+            break;
+        case WireType::Fixed32:
+            advance(4);
+            break;
+        default:
+            malformed();
+        }
+    }
+};
+}
+
+#endif // INCLUDE_VK_MEXC_PROTOBUF_READER_H
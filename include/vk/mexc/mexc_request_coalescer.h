@@ -0,0 +1,61 @@
+/**
+MEXC Request Coalescer
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_REQUEST_COALESCER_H
+#define INCLUDE_VK_MEXC_REQUEST_COALESCER_H
+
+#include <boost/beast/http.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <map>
+#include <memory>
+
+namespace vk::mexc {
+
+/**
+ * Single-flight execution of identical requests. When a request with the same key is already in flight, later
+ * callers do not send anything and wait for the result of the pending one instead.
+ */
+class RequestCoalescer {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+    RequestCoalescer();
+
+    ~RequestCoalescer();
+
+    /**
+     * Build coalescing key from the request path and its parameters
+     * @param path e.g. /api/v1/contract/ticker
+     * @param parameters query parameters
+     * @return key
+     */
+    static std::string makeKey(const std::string &path, const std::map<std::string, std::string> &parameters);
+
+    /**
+     * Run request or join the identical one which is already in flight. Exceptions thrown by the request are
+     * propagated to all joined callers.
+     * @param key request key, see makeKey
+     * @param request function performing the request
+     * @return response
+     */
+    Response run(const std::string &key, const std::function<Response()> &request) const;
+
+    /**
+     * Number of requests which were not sent because an identical request was already in flight
+     * @return count of coalesced requests
+     */
+    [[nodiscard]] std::int64_t coalescedCount() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_REQUEST_COALESCER_H
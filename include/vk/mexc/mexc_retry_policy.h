@@ -0,0 +1,85 @@
+/**
+MEXC Retry Policy
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_RETRY_POLICY_H
+#define INCLUDE_VK_MEXC_RETRY_POLICY_H
+
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace vk::mexc {
+
+struct RetrySettings {
+    /// Attempts including the first one, 1 disables retrying
+    int maxAttempts = 3;
+    std::chrono::milliseconds initialBackoff{200};
+    std::chrono::milliseconds maxBackoff{5000};
+    double backoffMultiplier = 2.0;
+    /// Consecutive failed requests of one endpoint which open its circuit
+    int failureThreshold = 5;
+    /// Time the circuit stays open before a single trial request is let through
+    std::chrono::milliseconds openDuration{30000};
+};
+
+struct RetryStats {
+    std::int64_t requests{};
+    std::int64_t retries{};
+    /// Requests which failed after all attempts
+    std::int64_t failures{};
+    /// Requests rejected without sending because the circuit was open
+    std::int64_t rejected{};
+    std::int64_t circuitOpenings{};
+    std::int64_t openCircuits{};
+};
+
+/**
+ * Retry policy for idempotent requests. Transport errors, HTTP 429 and 5xx responses are retried with exponential
+ * backoff and full jitter. Each endpoint has its own circuit breaker: after failureThreshold consecutive failures
+ * the circuit opens and requests fail fast until openDuration elapses, then one trial request decides whether
+ * the circuit closes again.
+ */
+class RetryPolicy {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+    RetryPolicy();
+
+    ~RetryPolicy();
+
+    void setSettings(const RetrySettings &settings) const;
+
+    [[nodiscard]] RetrySettings settings() const;
+
+    /**
+     * Run request according to the policy
+     * @param endpoint circuit breaker key, the route template of the request, e.g. /api/v1/contract/depth/{symbol}
+     * @param request function performing the request
+     * @return last response, it is not guaranteed to be successful when all attempts failed with an HTTP error, or
+     * when the circuit opened after a failed attempt
+     * @throws std::runtime_error if the circuit is open before the first attempt, otherwise the last exception of the
+     * request if the attempts threw until they ran out or the circuit opened
+     */
+    Response run(const std::string &endpoint, const std::function<Response()> &request) const;
+
+    /**
+     * @param endpoint circuit breaker key
+     * @return true if requests to the endpoint currently fail fast
+     */
+    [[nodiscard]] bool isCircuitOpen(const std::string &endpoint) const;
+
+    [[nodiscard]] RetryStats stats() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_RETRY_POLICY_H
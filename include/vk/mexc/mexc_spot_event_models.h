@@ -0,0 +1,135 @@
+/**
+MEXC Spot Event Data Models
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SPOT_EVENT_MODELS_H
+#define INCLUDE_VK_MEXC_SPOT_EVENT_MODELS_H
+
+#include "mexc_enums.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace vk::mexc::spot {
+struct PriceLevel {
+    double price{};
+    double quantity{};
+};
+
+struct Deal {
+    double price{};
+    double quantity{};
+    std::int32_t tradeType{}; ///< 1=buy, 2=sell
+    std::int64_t time{};
+};
+
+/// Aggregated trades, decoded from PublicAggreDealsV3Api
+struct EventDeals {
+    std::vector<Deal> deals{};
+
+    void fromProtobuf(std::string_view buffer);
+};
+
+/// Order book update, decoded from PublicAggreDepthsV3Api (incremental) or PublicLimitDepthsV3Api (snapshot)
+struct EventDepth {
+    bool isSnapshot{false};
+    std::int64_t fromVersion{};
+    std::int64_t toVersion{};
+    std::vector<PriceLevel> asks{};
+    std::vector<PriceLevel> bids{};
+
+    void fromProtobuf(std::string_view buffer, bool snapshot);
+};
+
+/// Candlestick update, decoded from PublicSpotKlineV3Api
+struct EventCandlestick {
+    CandleInterval interval{};
+    std::int64_t windowStart{}; ///< s
+    std::int64_t windowEnd{};   ///< s
+    double open{};
+    double close{};
+    double high{};
+    double low{};
+    double volume{};
+    double amount{};
+
+    void fromProtobuf(std::string_view buffer);
+};
+
+/// Order update from the user data stream, decoded from PrivateOrdersV3Api
+struct EventOrder {
+    std::string orderId{};
+    std::string clientOrderId{};
+    double price{};
+    double quantity{};
+    double amount{};
+    double avgPrice{};
+    std::int32_t orderType{};  ///< 1=limit, 2=post only, 3=IOC, 4=FOK, 5=market
+    std::int32_t tradeType{};  ///< 1=buy, 2=sell
+    bool isMaker{};
+    double remainAmount{};
+    double remainQuantity{};
+    double cumulativeQuantity{};
+    double cumulativeAmount{};
+    std::int32_t status{};     ///< 1=new, 2=filled, 3=partially filled, 4=canceled, 5=partially canceled
+    std::int64_t createTime{};
+
+    void fromProtobuf(std::string_view buffer);
+};
+
+/// Own trade from the user data stream, decoded from PrivateDealsV3Api
+struct EventFill {
+    double price{};
+    double quantity{};
+    double amount{};
+    std::int32_t tradeType{};  ///< 1=buy, 2=sell
+    bool isMaker{};
+    bool isSelfTrade{};
+    std::string tradeId{};
+    std::string clientOrderId{};
+    std::string orderId{};
+    double feeAmount{};
+    std::string feeCurrency{};
+    std::int64_t time{};
+
+    void fromProtobuf(std::string_view buffer);
+};
+
+/// Balance change from the user data stream, decoded from PrivateAccountV3Api
+struct EventBalance {
+    std::string asset{};
+    double balance{};
+    double balanceChange{};
+    double frozen{};
+    double frozenChange{};
+    std::string changeType{};
+    std::int64_t time{};
+
+    void fromProtobuf(std::string_view buffer);
+};
+
+/**
+ * Spot WebSocket push message, decoded from PushDataV3ApiWrapper
+ * @see https://github.com/mexcdevelop/websocket-proto
+ */
+struct Event {
+    std::string channel{};
+    std::string symbol{};
+    std::int64_t sendTime{};
+    std::variant<std::monostate, EventDeals, EventDepth, EventCandlestick, EventOrder, EventFill, EventBalance> data{};
+
+    /**
+     * Decode the binary frame, the buffer is parsed in place without intermediate copies
+     * @param buffer binary WebSocket frame
+     * @throws std::runtime_error if the message is malformed
+     */
+    void fromProtobuf(std::string_view buffer);
+};
+}
+#endif //INCLUDE_VK_MEXC_SPOT_EVENT_MODELS_H
@@ -14,6 +14,8 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include <functional>
 #include "mexc_models.h"
 #include "mexc_enums.h"
+#include "mexc_clock_sync.h"
+#include "mexc_retry_policy.h"
 
 namespace vk::mexc::spot {
 
@@ -58,6 +60,26 @@ public:
     */
     [[nodiscard]] std::int64_t getServerTime() const;
 
+    /**
+     * Estimate offset of the server clock NTP-style from several server time round trips, signed requests are
+     * timestamped with the corrected time afterward. Call it periodically to follow the drift of the local clock.
+     * @param samples number of round trips
+     * @return estimated server time minus local time in ms
+     * @throws nlohmann::json::exception, std::exception
+     */
+    std::int64_t synchronizeClock(int samples = 5) const;
+
+    /**
+     * @return clock estimate used to timestamp signed requests
+     */
+    [[nodiscard]] const ClockSync &clockSync() const;
+
+    /**
+     * Set time in ms after the request timestamp the signed requests are valid for, default is 25000
+     * @param receiveWindow window in ms, MEXC accepts at most 60000
+     */
+    void setReceiveWindow(int receiveWindow) const;
+
     /**
      * Returns Ticker price for a specified symbol
      * @param symbol Prices of all symbols will be sent if the symbol was not given
@@ -67,6 +89,32 @@ public:
      */
     [[nodiscard]] std::vector<TickerPrice> getTickerPrice(const std::string &symbol) const;
 
+    /**
+     * Returns prices of all symbols as a flat table sorted by symbol, suitable for fast lookups and for diffing
+     * against the previous snapshot
+     * @return Filled TickerPriceSnapshot structure
+     * @throws nlohmann::json::exception, std::exception
+     * @see https://mexcdevelop.github.io/apidocs/spot_v3_en/#symbol-price-ticker
+     */
+    [[nodiscard]] TickerPriceSnapshot getTickerPriceSnapshot() const;
+
+    /**
+     * Returns number of public requests which were not sent because an identical request was already in flight
+     * @return count of coalesced requests
+     */
+    [[nodiscard]] std::int64_t coalescedRequestsCount() const;
+
+    /**
+     * Configure retrying of public GET requests and the per-endpoint circuit breakers
+     * @param settings
+     */
+    void setRetrySettings(const RetrySettings &settings) const;
+
+    /**
+     * @return retry and circuit breaker counters of public GET requests
+     */
+    [[nodiscard]] RetryStats retryStats() const;
+
     /**
      * Starts a new data stream and return a listenKey for it. The stream will close 60 minutes after creation
      * unless a keepalive is sent.
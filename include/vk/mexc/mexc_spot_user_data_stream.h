@@ -0,0 +1,62 @@
+/**
+MEXC Spot User Data Stream
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SPOT_USER_DATA_STREAM_H
+#define INCLUDE_VK_MEXC_SPOT_USER_DATA_STREAM_H
+
+#include "vk/utils/log_utils.h"
+#include "vk/utils/utils.h"
+#include "mexc_spot_ws_session.h"
+#include <boost/asio/io_context.hpp>
+#include <memory>
+
+namespace vk::mexc::spot {
+/**
+ * Private user data stream (orders, fills and balances). The stream obtains a listen key, renews it every 30 minutes
+ * and reconnects with a new listen key when the connection is lost or the key cannot be renewed.
+ * @see https://www.mexc.com/api-docs/spot-v3/websocket-user-data-streams
+ */
+class UserDataStream : public noncopyable {
+    struct P;
+    std::shared_ptr<P> m_p{};
+
+public:
+    /**
+     * @param ioc IO context the stream runs on, it may be shared with other sessions and has to be run by the caller
+     * @param apiKey
+     * @param apiSecret
+     */
+    UserDataStream(boost::asio::io_context &ioc, const std::string &apiKey, const std::string &apiSecret);
+
+    ~UserDataStream();
+
+    /**
+     * Set logger callback, if no set then all errors are writen to the stderr stream only
+     * @param onLogMessageCB
+     */
+    void setLoggerCallback(const onLogMessage &onLogMessageCB) const;
+
+    /**
+     * Set Data Message callback, Event::data holds EventOrder, EventFill or EventBalance
+     * @param onDataEventCB
+     */
+    void setDataEventCallback(const onDataEvent &onDataEventCB) const;
+
+    /**
+     * Obtain listen key and connect, returns immediately
+     */
+    void start() const;
+
+    /**
+     * Disconnect and close the listen key, no reconnection is attempted afterward
+     */
+    void stop() const;
+};
+}
+
+#endif //INCLUDE_VK_MEXC_SPOT_USER_DATA_STREAM_H
@@ -0,0 +1,62 @@
+/**
+MEXC Spot WebSocket Client
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SPOT_WS_CLIENT_H
+#define INCLUDE_VK_MEXC_SPOT_WS_CLIENT_H
+
+#include <memory>
+
+#include "vk/utils/log_utils.h"
+#include "vk/utils/utils.h"
+#include "mexc_spot_ws_session.h"
+
+namespace vk::mexc::spot {
+class WSClient : public noncopyable {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    WSClient();
+
+    ~WSClient();
+
+    /**
+    * Run the WebSocket IO Context asynchronously and returns immediately without blocking the thread execution
+    */
+    void run() const;
+
+    /**
+     * Set logger callback, if no set then all errors are writen to the stderr stream only
+     * @param onLogMessageCB
+     */
+    void setLoggerCallback(const onLogMessage &onLogMessageCB) const;
+
+    /**
+     * Set Data Message callback, called from the IO thread with the decoded protobuf message
+     * @param onDataEventCB
+     */
+    void setDataEventCallback(const onDataEvent &onDataEventCB) const;
+
+    /**
+     * Subscribe channel, e.g. spot@public.aggre.deals.v3.api.pb@100ms@BTCUSDT. MEXC allows at most 30 channels
+     * per connection, a channel beyond the limit throws std::runtime_error instead of being refused by the server.
+     * @param channel
+     * @see https://mexcdevelop.github.io/apidocs/spot_v3_en/#websocket-market-streams
+     */
+    void subscribe(const std::string &channel) const;
+
+    /**
+     * Check if a channel is already subscribed
+     * @param channel
+     * @return True if subscribed
+     */
+    [[nodiscard]] bool isSubscribed(const std::string &channel) const;
+};
+}
+
+#endif //INCLUDE_VK_MEXC_SPOT_WS_CLIENT_H
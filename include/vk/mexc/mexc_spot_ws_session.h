@@ -0,0 +1,71 @@
+/**
+MEXC Spot WebSocket Session
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SPOT_WS_SESSION_H
+#define INCLUDE_VK_MEXC_SPOT_WS_SESSION_H
+
+#include "vk/utils/log_utils.h"
+#include "vk/mexc/mexc_spot_event_models.h"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <functional>
+#include <memory>
+
+namespace vk::mexc::spot {
+using onDataEvent = std::function<void(const Event& event)>;
+using onSessionClosed = std::function<void()>;
+
+class WebSocketSession final : public std::enable_shared_from_this<WebSocketSession> {
+    struct P;
+    std::unique_ptr<P> m_p;
+
+public:
+    explicit WebSocketSession(boost::asio::io_context& ioc, boost::asio::ssl::context& ctx,
+                              const onLogMessage& onLogMessageCB);
+
+    ~WebSocketSession();
+
+    /**
+     * Run the session.
+     * @param host
+     * @param port
+     * @param target e.g. /ws
+     * @param channels channels subscribed right after the connection is established
+     * @param dataEventCB Data Message callback
+     */
+    void run(const std::string& host, const std::string& port, const std::string& target,
+             const std::vector<std::string>& channels, const onDataEvent& dataEventCB);
+
+    /**
+     * Set callback invoked once when the connection cannot be established or is lost, must be set before run
+     * @param sessionClosedCB
+     */
+    void setSessionClosedCallback(const onSessionClosed& sessionClosedCB) const;
+
+    /**
+     * Close the session asynchronously
+     */
+    void close() const;
+
+    /**
+     * Subscribe channel, e.g. spot@public.aggre.deals.v3.api.pb@100ms@BTCUSDT. Throws std::runtime_error when the
+     * connection already has 30 subscribed or pending channels.
+     * @param channel
+     * @see https://mexcdevelop.github.io/apidocs/spot_v3_en/#websocket-market-streams
+     */
+    void subscribe(const std::string& channel);
+
+    /**
+     * Check if a channel is already subscribed
+     * @param channel
+     * @return True if subscribed
+     */
+    [[nodiscard]] bool isSubscribed(const std::string& channel) const;
+};
+}
+#endif //INCLUDE_VK_MEXC_SPOT_WS_SESSION_H
@@ -0,0 +1,90 @@
+/**
+MEXC Spot WebSocket Stream manager
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SPOT_WS_STREAM_MANAGER_H
+#define INCLUDE_VK_MEXC_SPOT_WS_STREAM_MANAGER_H
+
+#include "vk/utils/log_utils.h"
+#include "vk/mexc/mexc_spot_event_models.h"
+#include <memory>
+#include <optional>
+
+namespace vk::mexc::spot {
+class WSStreamManager {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+public:
+    explicit WSStreamManager();
+
+    ~WSStreamManager();
+
+    /**
+     * Check if the aggregated Deals Stream is subscribed for a selected pair, if not then subscribe it
+     * @param pair e.g BTCUSDT
+     */
+    void subscribeDealsStream(const std::string& pair) const;
+
+    /**
+     * Check if the limited Depth Stream is subscribed for a selected pair, if not then subscribe it
+     * @param pair e.g BTCUSDT
+     * @param levels number of levels, one of 5, 10, 20
+     */
+    void subscribeDepthStream(const std::string& pair, int levels = 20) const;
+
+    /**
+     * Check if the Candlestick Stream is subscribed for a selected pair, if not then subscribe it
+     * @param pair e.g BTCUSDT
+     * @param interval e.g CandleInterval::_1m
+     */
+    void subscribeCandlestickStream(const std::string& pair, CandleInterval interval) const;
+
+    /**
+     * Set time of all reading operations
+     * @param seconds
+     */
+    void setTimeout(int seconds) const;
+
+    /**
+     * Get time of all reading operations
+     * @return
+     */
+    [[nodiscard]] int timeout() const;
+
+    /**
+     * Set logger callback, if no set then all errors are writen to the stderr stream only
+     * @param onLogMessageCB
+     */
+    void setLoggerCallback(const onLogMessage& onLogMessageCB) const;
+
+    /**
+     * Try to read the last batch of deals. It will block at most Timeout time.
+     * @param pair e.g BTCUSDT
+     * @return EventDeals structure if successful
+     */
+    [[nodiscard]] std::optional<EventDeals> readEventDeals(const std::string& pair) const;
+
+    /**
+     * Try to read the last order book snapshot. It will block at most Timeout time.
+     * @param pair e.g BTCUSDT
+     * @return EventDepth structure if successful
+     */
+    [[nodiscard]] std::optional<EventDepth> readEventDepth(const std::string& pair) const;
+
+    /**
+     * Try to read EventCandlestick structure. It will block at most Timeout time.
+     * @param pair e.g BTCUSDT
+     * @param interval e.g CandleInterval::_1m
+     * @return EventCandlestick structure if successful
+     */
+    [[nodiscard]] std::optional<EventCandlestick>
+    readEventCandlestick(const std::string& pair, CandleInterval interval) const;
+};
+}
+
+#endif //INCLUDE_VK_MEXC_SPOT_WS_STREAM_MANAGER_H
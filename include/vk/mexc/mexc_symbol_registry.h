@@ -0,0 +1,83 @@
+/**
+MEXC Symbol Registry
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_SYMBOL_REGISTRY_H
+#define INCLUDE_VK_MEXC_SYMBOL_REGISTRY_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vk::mexc {
+namespace futures {
+struct ContractDetail;
+}
+
+/// Dense ID of an interned symbol, IDs start at 0 and are never reused
+using SymbolId = std::uint32_t;
+
+constexpr SymbolId INVALID_SYMBOL_ID = std::numeric_limits<SymbolId>::max();
+
+/**
+ * Process-wide table of interned symbols. Each symbol gets a dense ID on the first use, so caches keyed by symbol
+ * can be plain vectors indexed by the ID and symbols are compared as integers. Seeding it from the contract details
+ * at startup gives the contracts consecutive IDs in the order of the exchange list. All methods are thread-safe,
+ * names returned by name() stay valid for the lifetime of the process.
+ */
+class SymbolRegistry {
+    struct P;
+    std::unique_ptr<P> m_p{};
+
+    SymbolRegistry();
+
+public:
+    ~SymbolRegistry();
+
+    SymbolRegistry(const SymbolRegistry &) = delete;
+
+    SymbolRegistry &operator=(const SymbolRegistry &) = delete;
+
+    static SymbolRegistry &instance();
+
+    /**
+     * Return ID of the symbol, a new one is assigned if the symbol is not registered yet
+     * @param symbol e.g. BTC_USDT
+     * @return ID
+     */
+    SymbolId intern(std::string_view symbol) const;
+
+    /**
+     * Intern symbols of all contracts
+     * @param contractDetails e.g. result of futures::RESTClient::getContractDetails
+     */
+    void seed(const std::vector<futures::ContractDetail> &contractDetails) const;
+
+    /**
+     * @param symbol e.g. BTC_USDT
+     * @return ID, std::nullopt if the symbol is not registered
+     */
+    [[nodiscard]] std::optional<SymbolId> find(std::string_view symbol) const;
+
+    /**
+     * @param id
+     * @return symbol, empty if the ID is not assigned
+     */
+    [[nodiscard]] std::string_view name(SymbolId id) const;
+
+    /**
+     * @return number of registered symbols, all IDs are lower
+     */
+    [[nodiscard]] std::size_t size() const;
+};
+}
+
+#endif // INCLUDE_VK_MEXC_SYMBOL_REGISTRY_H
@@ -11,6 +11,7 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 
 #include "vk/utils/log_utils.h"
 #include "vk/mexc/mexc_event_models.h"
+#include "vk/mexc/mexc_order_book.h"
 #include <optional>
 
 namespace vk::mexc::futures {
@@ -38,6 +39,21 @@ public:
      */
     void subscribeCandlestickStream(const std::string& pair, CandleInterval interval) const;
 
+    /**
+     * Check if the Depth Stream is subscribed for a selected pair, if not then subscribe it. The local order book is
+     * synced from the REST snapshot and kept up to date by the incremental updates, a version gap triggers a resync.
+     * @param pair e.g BTC_USDT
+     */
+    void subscribeDepthStream(const std::string& pair) const;
+
+    /**
+     * Check if the Full Depth Stream is subscribed for a selected pair, if not then subscribe it. Each push replaces
+     * the local order book by the top levels.
+     * @param pair e.g BTC_USDT
+     * @param limit levels per side, 5, 10 or 20
+     */
+    void subscribeFullDepthStream(const std::string& pair, int limit = 20) const;
+
     /**
      * Set time of all reading operations
      * @param seconds
@@ -63,6 +79,13 @@ public:
      */
     [[nodiscard]] std::optional<EventTicker> readEventTicker(const std::string& pair) const;
 
+    /**
+     * Try to read EventTicker structure by symbol ID, see SymbolRegistry. It will block at most Timeout time.
+     * @param symbolId ID of the pair
+     * @return EventTicker structure if successful
+     */
+    [[nodiscard]] std::optional<EventTicker> readEventTicker(SymbolId symbolId) const;
+
     /**
      * Try to read EventCandlestick structure. It will block at most Timeout time.
      * @param pair e.g BTCUSDT
@@ -71,6 +94,37 @@ public:
      */
     [[nodiscard]] std::optional<EventCandlestick>
     readEventCandlestick(const std::string& pair, CandleInterval interval) const;
+
+    /**
+     * Try to read EventCandlestick structure by symbol ID, see SymbolRegistry. It will block at most Timeout time.
+     * @param symbolId ID of the pair
+     * @param interval e.g CandleInterval::_1
+     * @return EventCandlestick structure if successful
+     */
+    [[nodiscard]] std::optional<EventCandlestick> readEventCandlestick(SymbolId symbolId, CandleInterval interval) const;
+
+    /**
+     * Get local order book of a pair, its top() and depth() reads are lock-free
+     * @param pair e.g BTC_USDT
+     * @return order book, nullptr if no Depth Stream of the pair is subscribed
+     */
+    [[nodiscard]] std::shared_ptr<const OrderBook> orderBook(const std::string& pair) const;
+
+    /**
+     * Try to read the best bid and ask. It will block at most Timeout time while the order book is not in sync.
+     * @param pair e.g BTC_USDT
+     * @return BookTop structure if successful
+     */
+    [[nodiscard]] std::optional<BookTop> readBookTop(const std::string& pair) const;
+
+    /**
+     * Try to read the best levels of the order book. It will block at most Timeout time while the order book is not
+     * in sync.
+     * @param pair e.g BTC_USDT
+     * @param levels per side, at most 20
+     * @return BookDepth structure if successful
+     */
+    [[nodiscard]] std::optional<BookDepth> readBookDepth(const std::string& pair, std::size_t levels) const;
 };
 }
 
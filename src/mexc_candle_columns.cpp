@@ -0,0 +1,368 @@
+/**
+MEXC Candle Columns
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_candle_columns.h"
+#include "vk/mexc/mexc.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace vk::mexc {
+namespace {
+constexpr std::int64_t DAY_MS = 86400000;
+
+/// 1970-01-01 was a Thursday, the first Monday after the epoch starts 4 days later
+constexpr std::int64_t FIRST_MONDAY_MS = 4 * DAY_MS;
+
+void readColumn(const nlohmann::json &data, const std::string &key, std::vector<double> &column, const std::size_t count) {
+    const auto &values = data.at(key);
+
+    if (values.size() != count) {
+        throw std::runtime_error("Kline column size mismatch: " + key);
+    }
+
+    column.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        column[i] = values[i].get<double>();
+    }
+}
+
+template<typename Compare>
+std::vector<double> rollingExtreme(const std::vector<double> &values, const std::size_t window, Compare compare) {
+    if (window == 0) {
+        throw std::invalid_argument("Rolling window must be at least 1");
+    }
+
+    std::vector<double> retVal(values.size());
+
+    /// Indexes of values which can still become the extreme of some window, the front is the current extreme
+    std::deque<std::size_t> candidates;
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        while (!candidates.empty() && !compare(values[candidates.back()], values[i])) {
+            candidates.pop_back();
+        }
+
+        candidates.push_back(i);
+
+        if (candidates.front() + window <= i) {
+            candidates.pop_front();
+        }
+
+        retVal[i] = values[candidates.front()];
+    }
+
+    return retVal;
+}
+
+template<typename CandleType>
+CandleColumns fromCandleRows(const std::vector<CandleType> &candles) {
+    CandleColumns retVal;
+    retVal.reserve(candles.size());
+
+    for (const auto &candle: candles) {
+        if constexpr (std::is_same_v<CandleType, spot::Candle>) {
+            retVal.push_back(candle.openTime, candle.open.template convert_to<double>(),
+                             candle.high.template convert_to<double>(), candle.low.template convert_to<double>(),
+                             candle.close.template convert_to<double>(), candle.volume.template convert_to<double>(),
+                             candle.quoteAssetVolume.template convert_to<double>());
+        } else {
+            retVal.push_back(candle.openTime, candle.open.template convert_to<double>(),
+                             candle.high.template convert_to<double>(), candle.low.template convert_to<double>(),
+                             candle.close.template convert_to<double>(), candle.volume.template convert_to<double>(),
+                             candle.amount.template convert_to<double>());
+        }
+    }
+
+    return retVal;
+}
+
+std::int64_t floorTo(const std::int64_t time, const std::int64_t step, const std::int64_t origin) {
+    auto offset = (time - origin) % step;
+
+    if (offset < 0) {
+        offset += step;
+    }
+
+    return time - offset;
+}
+
+/// Start of the bucket holding time and start of the next one
+std::pair<std::int64_t, std::int64_t> bucketOf(const std::int64_t time, const CandleInterval interval,
+                                               const std::int64_t intervalMs) {
+    switch (interval) {
+    case CandleInterval::_1W: {
+        const auto begin = floorTo(time, intervalMs, FIRST_MONDAY_MS);
+        return {begin, begin + intervalMs};
+    }
+    case CandleInterval::_1M: {
+        using namespace std::chrono;
+        const year_month_day day{floor<days>(sys_time<milliseconds>(milliseconds(time)))};
+        const auto month = day.year() / day.month();
+        const auto begin = sys_days(month / 1);
+        const auto end = sys_days((month + months(1)) / 1);
+        return {duration_cast<milliseconds>(begin.time_since_epoch()).count(),
+                duration_cast<milliseconds>(end.time_since_epoch()).count()};
+    }
+    default: {
+        const auto begin = floorTo(time, intervalMs, 0);
+        return {begin, begin + intervalMs};
+    }
+    }
+}
+
+void checkResampleIntervals(const CandleInterval sourceInterval, const CandleInterval targetInterval) {
+    const auto sourceMs = MEXC::numberOfMsForCandleInterval(sourceInterval);
+    const auto targetMs = MEXC::numberOfMsForCandleInterval(targetInterval);
+
+    if (sourceMs <= 0 || targetMs <= 0) {
+        throw std::invalid_argument("Unsupported candle interval");
+    }
+
+    /// A calendar month is a whole number of days, but not of weeks
+    const auto isMultiple = targetInterval == CandleInterval::_1M
+                                ? sourceInterval == CandleInterval::_1M || DAY_MS % sourceMs == 0
+                                : sourceInterval != CandleInterval::_1M && targetMs % sourceMs == 0;
+
+    if (!isMultiple) {
+        throw std::invalid_argument("Target candle interval is not a multiple of the source one");
+    }
+}
+
+/**
+ * Reduce values[0, count) keeping four independent accumulators, the loop has no serial dependency on one
+ * accumulator so it maps onto SIMD lanes without relaxing the floating point rules
+ */
+template<typename Combine>
+double reduce(const double *values, const std::size_t count, const double init, Combine combine) {
+    double lanes[4] = {init, init, init, init};
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        lanes[0] = combine(lanes[0], values[i]);
+        lanes[1] = combine(lanes[1], values[i + 1]);
+        lanes[2] = combine(lanes[2], values[i + 2]);
+        lanes[3] = combine(lanes[3], values[i + 3]);
+    }
+
+    for (; i < count; ++i) {
+        lanes[0] = combine(lanes[0], values[i]);
+    }
+
+    return combine(combine(lanes[0], lanes[1]), combine(lanes[2], lanes[3]));
+}
+
+/// Reduce each bucket [ends[b - 1], ends[b]) of a column
+template<typename Combine>
+void reduceBuckets(const std::vector<double> &column, const std::vector<std::size_t> &ends,
+                   std::vector<double> &target, const bool sum, Combine combine) {
+    target.resize(ends.size());
+    std::size_t first = 0;
+
+    for (std::size_t b = 0; b < ends.size(); ++b) {
+        const auto *values = column.data() + first;
+        target[b] = reduce(values, ends[b] - first, sum ? 0.0 : values[0], combine);
+        first = ends[b];
+    }
+}
+
+template<typename T>
+void prependColumn(std::vector<T> &column, const std::vector<T> &other) {
+    column.insert(column.begin(), other.begin(), other.end());
+}
+}
+
+void CandleColumns::reserve(const std::size_t count) {
+    openTime.reserve(count);
+    open.reserve(count);
+    high.reserve(count);
+    low.reserve(count);
+    close.reserve(count);
+    volume.reserve(count);
+    amount.reserve(count);
+}
+
+void CandleColumns::clear() {
+    openTime.clear();
+    open.clear();
+    high.clear();
+    low.clear();
+    close.clear();
+    volume.clear();
+    amount.clear();
+}
+
+void CandleColumns::push_back(const std::int64_t time, const double o, const double h, const double l, const double c,
+                              const double v, const double a) {
+    openTime.push_back(time);
+    open.push_back(o);
+    high.push_back(h);
+    low.push_back(l);
+    close.push_back(c);
+    volume.push_back(v);
+    amount.push_back(a);
+}
+
+void CandleColumns::prepend(const CandleColumns &other) {
+    prependColumn(openTime, other.openTime);
+    prependColumn(open, other.open);
+    prependColumn(high, other.high);
+    prependColumn(low, other.low);
+    prependColumn(close, other.close);
+    prependColumn(volume, other.volume);
+    prependColumn(amount, other.amount);
+}
+
+void CandleColumns::pop_back() {
+    openTime.pop_back();
+    open.pop_back();
+    high.pop_back();
+    low.pop_back();
+    close.pop_back();
+    volume.pop_back();
+    amount.pop_back();
+}
+
+CandleColumns CandleColumns::fromFuturesJson(const nlohmann::json &data) {
+    CandleColumns retVal;
+
+    if (!data.contains("time") || data["time"].empty()) {
+        return retVal;
+    }
+
+    const auto &times = data["time"];
+    const auto count = times.size();
+    retVal.openTime.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        retVal.openTime[i] = times[i].get<std::int64_t>() * 1000; // Convert seconds to ms
+    }
+
+    readColumn(data, "open", retVal.open, count);
+    readColumn(data, "high", retVal.high, count);
+    readColumn(data, "low", retVal.low, count);
+    readColumn(data, "close", retVal.close, count);
+    readColumn(data, "vol", retVal.volume, count);
+    readColumn(data, "amount", retVal.amount, count);
+    return retVal;
+}
+
+CandleColumns CandleColumns::fromCandles(const std::vector<futures::Candle> &candles) {
+    return fromCandleRows(candles);
+}
+
+CandleColumns CandleColumns::fromCandles(const std::vector<spot::Candle> &candles) {
+    return fromCandleRows(candles);
+}
+
+CandleColumns resample(const CandleColumns &candles, const CandleInterval sourceInterval,
+                       const CandleInterval targetInterval) {
+    checkResampleIntervals(sourceInterval, targetInterval);
+    const auto intervalMs = MEXC::numberOfMsForCandleInterval(targetInterval);
+
+    CandleColumns retVal;
+
+    /// Bucket boundaries first, then every column is reduced on its own over plain arrays
+    std::vector<std::size_t> ends;
+
+    for (std::size_t first = 0; first < candles.size();) {
+        const auto [begin, end] = bucketOf(candles.openTime[first], targetInterval, intervalMs);
+        auto last = first + 1;
+
+        while (last < candles.size() && candles.openTime[last] < end) {
+            ++last;
+        }
+
+        retVal.openTime.push_back(begin);
+        retVal.open.push_back(candles.open[first]);
+        retVal.close.push_back(candles.close[last - 1]);
+        ends.push_back(last);
+        first = last;
+    }
+
+    reduceBuckets(candles.high, ends, retVal.high, false, [](const double a, const double b) {
+        return a < b ? b : a;
+    });
+    reduceBuckets(candles.low, ends, retVal.low, false, [](const double a, const double b) {
+        return b < a ? b : a;
+    });
+    reduceBuckets(candles.volume, ends, retVal.volume, true, std::plus<>());
+    reduceBuckets(candles.amount, ends, retVal.amount, true, std::plus<>());
+    return retVal;
+}
+
+std::vector<double> rollingMin(const std::vector<double> &values, const std::size_t window) {
+    return rollingExtreme(values, window, std::less<>());
+}
+
+std::vector<double> rollingMax(const std::vector<double> &values, const std::size_t window) {
+    return rollingExtreme(values, window, std::greater<>());
+}
+
+double vwap(const CandleColumns &candles) {
+    double weightedSum = 0.0;
+    double volumeSum = 0.0;
+    const auto count = candles.size();
+    const auto *high = candles.high.data();
+    const auto *low = candles.low.data();
+    const auto *close = candles.close.data();
+    const auto *volume = candles.volume.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        weightedSum += (high[i] + low[i] + close[i]) / 3.0 * volume[i];
+        volumeSum += volume[i];
+    }
+
+    return volumeSum > 0.0 ? weightedSum / volumeSum : 0.0;
+}
+
+std::vector<double> returns(const std::vector<double> &values, const bool logarithmic) {
+    if (values.size() < 2) {
+        return {};
+    }
+
+    std::vector<double> retVal(values.size() - 1);
+    const auto *previous = values.data();
+    const auto *current = values.data() + 1;
+
+    for (std::size_t i = 0; i < retVal.size(); ++i) {
+        retVal[i] = current[i] / previous[i];
+    }
+
+    if (logarithmic) {
+        std::transform(retVal.begin(), retVal.end(), retVal.begin(), [](const double ratio) { return std::log(ratio); });
+    } else {
+        std::transform(retVal.begin(), retVal.end(), retVal.begin(), [](const double ratio) { return ratio - 1.0; });
+    }
+
+    return retVal;
+}
+
+std::vector<CandleGap> findGaps(const CandleColumns &candles, const CandleInterval interval) {
+    const auto intervalMs = MEXC::numberOfMsForCandleInterval(interval);
+
+    if (intervalMs <= 0) {
+        throw std::invalid_argument("Unsupported candle interval");
+    }
+
+    std::vector<CandleGap> retVal;
+
+    for (std::size_t i = 1; i < candles.size(); ++i) {
+        if (const auto diff = candles.openTime[i] - candles.openTime[i - 1]; diff != intervalMs) {
+            retVal.push_back({i, diff / intervalMs - 1});
+        }
+    }
+
+    return retVal;
+}
+}
@@ -0,0 +1,98 @@
+/**
+MEXC Futures WebSocket Channel Registry
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_channel_registry.h"
+#include "vk/mexc/mexc_json_fields.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace vk::mexc::futures {
+namespace {
+/// Seeds tried for one table size before the table is doubled
+constexpr std::uint32_t SEEDS_PER_SIZE = 1000;
+}
+
+std::size_t ChannelRegistry::slotOf(const std::string_view channel) const {
+    return detail::mix(detail::fnv1a(channel, m_seed)) >> (32 - m_slotBits);
+}
+
+void ChannelRegistry::rehash() {
+    if (m_entries.size() >= EMPTY) {
+        throw std::runtime_error("Too many channels in the registry");
+    }
+
+    for (auto slots = std::bit_ceil(std::max<std::size_t>(m_entries.size() * 2, 2)); slots <= (1u << 31); slots *= 2) {
+        m_slotBits = std::countr_zero(slots);
+
+        for (m_seed = 0; m_seed < SEEDS_PER_SIZE; ++m_seed) {
+            m_slots.assign(slots, EMPTY);
+            bool isPerfect = true;
+
+            for (std::size_t i = 0; i < m_entries.size() && isPerfect; ++i) {
+                if (auto &slot = m_slots[slotOf(m_entries[i].channel)]; slot == EMPTY) {
+                    slot = static_cast<std::uint16_t>(i);
+                } else {
+                    isPerfect = false;
+                }
+            }
+
+            if (isPerfect) {
+                return;
+            }
+        }
+    }
+
+    throw std::runtime_error("No perfect hash found for the channel registry");
+}
+
+void ChannelRegistry::set(const std::string_view channel, onChannelFrame handler) {
+    if (const auto it = std::ranges::find(m_entries, channel, &Entry::channel); it != m_entries.end()) {
+        it->handler = std::move(handler);
+        return;
+    }
+
+    m_entries.push_back({std::string(channel), std::move(handler)});
+    rehash();
+}
+
+bool ChannelRegistry::erase(const std::string_view channel) {
+    if (const auto it = std::ranges::find(m_entries, channel, &Entry::channel); it != m_entries.end()) {
+        m_entries.erase(it);
+        rehash();
+        return true;
+    }
+
+    return false;
+}
+
+const onChannelFrame *ChannelRegistry::find(const std::string_view channel) const {
+    if (m_entries.empty()) {
+        return nullptr;
+    }
+
+    if (const auto index = m_slots[slotOf(channel)]; index != EMPTY && m_entries[index].channel == channel) {
+        return &m_entries[index].handler;
+    }
+
+    return nullptr;
+}
+
+bool ChannelRegistry::dispatch(const EventFrame &eventFrame) const {
+    if (const auto *handler = find(eventFrame.channel); handler && *handler) {
+        (*handler)(eventFrame);
+        return true;
+    }
+
+    return false;
+}
+
+std::size_t ChannelRegistry::size() const {
+    return m_entries.size();
+}
+}
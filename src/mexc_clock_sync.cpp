@@ -0,0 +1,72 @@
+/**
+MEXC Clock Synchronization
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_clock_sync.h"
+#include "vk/utils/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace vk::mexc {
+struct ClockSync::P {
+    struct Sample {
+        std::int64_t offset{};
+        std::int64_t roundTrip{};
+    };
+
+    std::mutex mutex;
+    std::deque<Sample> samples;
+    std::atomic<bool> synchronized{false};
+    std::atomic<std::int64_t> offset{0};
+    std::atomic<std::int64_t> roundTrip{0};
+};
+
+ClockSync::ClockSync() : m_p(std::make_unique<P>()) {
+}
+
+ClockSync::~ClockSync() = default;
+
+void ClockSync::addSample(const std::int64_t requestTime, const std::int64_t serverTime,
+                          const std::int64_t responseTime) const {
+    const auto roundTrip = std::max<std::int64_t>(responseTime - requestTime, 0);
+    const auto offset = serverTime - (requestTime + roundTrip / 2);
+
+    std::lock_guard lk(m_p->mutex);
+    m_p->samples.push_back({offset, roundTrip});
+
+    if (m_p->samples.size() > WINDOW_SIZE) {
+        m_p->samples.pop_front();
+    }
+
+    const auto best = std::min_element(m_p->samples.begin(), m_p->samples.end(),
+                                       [](const P::Sample &a, const P::Sample &b) {
+                                           return a.roundTrip < b.roundTrip;
+                                       });
+
+    m_p->offset = best->offset;
+    m_p->roundTrip = best->roundTrip;
+    m_p->synchronized = true;
+}
+
+bool ClockSync::isSynchronized() const {
+    return m_p->synchronized;
+}
+
+std::int64_t ClockSync::offset() const {
+    return m_p->offset;
+}
+
+std::int64_t ClockSync::roundTrip() const {
+    return m_p->roundTrip;
+}
+
+std::int64_t ClockSync::now() const {
+    return getMsTimestamp(currentTime()).count() + m_p->offset;
+}
+}
@@ -0,0 +1,158 @@
+/**
+MEXC Contract Details View
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_contract_details_view.h"
+#include "vk/mexc/mexc_json_scanner.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace vk::mexc::futures {
+std::optional<std::string_view> ContractDetailRef::rawValue(const std::string_view key) const {
+    std::optional<std::string_view> retVal;
+    JsonScanner scanner(m_object);
+
+    scanner.readObject([&](const std::string_view memberKey) {
+        if (memberKey != key || retVal) {
+            scanner.skipValue();
+        } else if (!scanner.readNull()) {
+            const auto next = scanner.peek();
+            retVal = next == '{' || next == '[' ? scanner.skipValue() : scanner.readToken();
+        }
+    });
+
+    return retVal;
+}
+
+std::string ContractDetailRef::getString(const std::string_view key) const {
+    if (const auto value = rawValue(key)) {
+        return JsonScanner::unescape(*value);
+    }
+
+    return {};
+}
+
+double ContractDetailRef::getDouble(const std::string_view key, const double defaultValue) const {
+    if (const auto value = rawValue(key)) {
+        return JsonScanner(*value).readDouble();
+    }
+
+    return defaultValue;
+}
+
+std::int64_t ContractDetailRef::getInt(const std::string_view key, const std::int64_t defaultValue) const {
+    if (const auto value = rawValue(key)) {
+        return JsonScanner(*value).readInt();
+    }
+
+    return defaultValue;
+}
+
+bool ContractDetailRef::getBool(const std::string_view key, const bool defaultValue) const {
+    if (const auto value = rawValue(key)) {
+        return JsonScanner(*value).readBool();
+    }
+
+    return defaultValue;
+}
+
+ContractDetail ContractDetailRef::decode() const {
+    ContractDetail retVal;
+    retVal.fromJson(nlohmann::json::parse(m_object));
+    return retVal;
+}
+
+ContractDetailsView::ContractDetailsView(std::string body) : m_body(std::move(body)) {
+    if (m_body.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Contract details response is too large");
+    }
+
+    JsonScanner scanner(m_body);
+
+    const auto indexContract = [&] {
+        if (scanner.peek() != '{') {
+            scanner.skipValue();
+            return;
+        }
+
+        Entry entry;
+        entry.begin = static_cast<std::uint32_t>(scanner.position());
+
+        scanner.readObject([&](const std::string_view key) {
+            if (key == "symbol" && scanner.peek() == '"') {
+                const auto symbol = scanner.readString();
+                entry.symbolBegin = static_cast<std::uint32_t>(symbol.data() - m_body.data());
+                entry.symbolLength = static_cast<std::uint32_t>(symbol.size());
+            } else {
+                scanner.skipValue();
+            }
+        });
+
+        entry.length = static_cast<std::uint32_t>(scanner.position()) - entry.begin;
+        m_entries.push_back(entry);
+    };
+
+    scanner.readObject([&](const std::string_view key) {
+        if (scanner.readNull()) {
+            return;
+        }
+
+        if (key == "code") {
+            m_code = static_cast<int>(scanner.readInt());
+        } else if (key == "success") {
+            m_success = scanner.readBool();
+        } else if (key == "data" && scanner.peek() == '[') {
+            scanner.readArray(indexContract);
+        } else if (key == "data") {
+            /// A single object is returned when the symbol is specified
+            indexContract();
+        } else {
+            scanner.skipValue();
+        }
+    });
+
+    m_bySymbol.resize(m_entries.size());
+
+    for (std::uint32_t i = 0; i < m_bySymbol.size(); ++i) {
+        m_bySymbol[i] = i;
+    }
+
+    std::sort(m_bySymbol.begin(), m_bySymbol.end(), [this](const std::uint32_t a, const std::uint32_t b) {
+        return symbolOf(m_entries[a]) < symbolOf(m_entries[b]);
+    });
+}
+
+ContractDetailRef ContractDetailsView::operator[](const std::size_t index) const {
+    const auto &entry = m_entries.at(index);
+    return ContractDetailRef(std::string_view(m_body).substr(entry.begin, entry.length));
+}
+
+std::optional<ContractDetailRef> ContractDetailsView::find(const std::string_view symbol) const {
+    const auto it = std::lower_bound(m_bySymbol.begin(), m_bySymbol.end(), symbol,
+                                     [this](const std::uint32_t index, const std::string_view value) {
+                                         return symbolOf(m_entries[index]) < value;
+                                     });
+
+    if (it == m_bySymbol.end() || symbolOf(m_entries[*it]) != symbol) {
+        return std::nullopt;
+    }
+
+    return (*this)[*it];
+}
+
+std::vector<ContractDetail> ContractDetailsView::decodeAll() const {
+    std::vector<ContractDetail> retVal;
+    retVal.reserve(m_entries.size());
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i) {
+        retVal.push_back((*this)[i].decode());
+    }
+
+    return retVal;
+}
+}
@@ -0,0 +1,197 @@
+/**
+MEXC Contract Index
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_contract_index.h"
+#include <cmath>
+#include <fmt/format.h>
+
+namespace vk::mexc::futures {
+namespace {
+/// Tolerance in steps, absorbs the error of the binary representation of decimal prices, e.g. 0.3 / 0.1
+constexpr double STEP_EPSILON = 1e-6;
+
+/**
+ * @param scale 10^precision
+ * @param inverseScale 10^-precision, the quotient by scale is computed as a product and corrected by one fma step,
+ * which gives the correctly rounded quotient without a division
+ */
+double roundToStep(const double value, const double step, const double inverseStep, const double scale,
+                   const double inverseScale, const Rounding rounding) {
+    const auto steps = value * inverseStep;
+    double rounded;
+
+    switch (rounding) {
+    case Rounding::Down:
+        rounded = std::floor(steps + STEP_EPSILON);
+        break;
+    case Rounding::Up:
+        rounded = std::ceil(steps - STEP_EPSILON);
+        break;
+    default:
+        rounded = std::round(steps);
+    }
+
+    const auto units = std::round(rounded * step * scale);
+    const auto quotient = units * inverseScale;
+    return std::fma(std::fma(-quotient, scale, units), inverseScale, quotient);
+}
+
+bool isOnStep(const double value, const double inverseStep) {
+    const auto steps = value * inverseStep;
+    return std::abs(steps - std::nearbyint(steps)) <= STEP_EPSILON;
+}
+
+bool hasPrice(const OrderType type) {
+    return type != OrderType::Market && type != OrderType::MarketToLimit;
+}
+
+double positiveOr(const double value, const double fallback) {
+    return value > 0.0 ? value : fallback;
+}
+}
+
+double ContractRules::roundPrice(const double price, const Rounding rounding) const {
+    return roundToStep(price, priceUnit, inversePriceUnit, priceScale, inversePriceScale, rounding);
+}
+
+double ContractRules::roundVolume(const double volume, const Rounding rounding) const {
+    return roundToStep(volume, volUnit, inverseVolUnit, volScale, inverseVolScale, rounding);
+}
+
+bool ContractRules::isPriceOnTick(const double price) const {
+    return isOnStep(price, inversePriceUnit);
+}
+
+bool ContractRules::isVolumeOnStep(const double volume) const {
+    return isOnStep(volume, inverseVolUnit);
+}
+
+struct ContractIndex::P {
+    /// Indexed by SymbolId, the IDs of the contracts are dense when the registry was seeded from the same list
+    std::vector<std::optional<ContractRules>> rules;
+    std::size_t count{};
+};
+
+ContractIndex::ContractIndex(const std::vector<ContractDetail> &contractDetails) : m_p(std::make_unique<P>()) {
+    auto &registry = SymbolRegistry::instance();
+    registry.seed(contractDetails);
+
+    for (const auto &detail: contractDetails) {
+        ContractRules rules;
+        rules.symbol = detail.symbol;
+        rules.state = detail.state;
+        rules.apiAllowed = detail.apiAllowed;
+        rules.contractSize = detail.contractSize;
+        rules.priceUnit = positiveOr(detail.priceUnit, std::pow(10.0, -detail.pricePrecision));
+        rules.volUnit = positiveOr(detail.volUnit, 1.0);
+        rules.minVol = detail.minVol;
+        rules.maxVol = detail.maxVol;
+        rules.pricePrecision = detail.pricePrecision;
+        rules.volPrecision = detail.volPrecision;
+        rules.inversePriceUnit = 1.0 / rules.priceUnit;
+        rules.inverseVolUnit = 1.0 / rules.volUnit;
+        rules.priceScale = std::pow(10.0, detail.pricePrecision);
+        rules.volScale = std::pow(10.0, detail.volPrecision);
+        rules.inversePriceScale = 1.0 / rules.priceScale;
+        rules.inverseVolScale = 1.0 / rules.volScale;
+
+        const auto id = registry.intern(detail.symbol);
+
+        if (m_p->rules.size() <= id) {
+            m_p->rules.resize(id + 1);
+        }
+
+        if (!m_p->rules[id]) {
+            ++m_p->count;
+        }
+
+        m_p->rules[id] = std::move(rules);
+    }
+}
+
+ContractIndex::~ContractIndex() = default;
+
+const ContractRules *ContractIndex::find(const std::string_view symbol) const {
+    if (const auto id = SymbolRegistry::instance().find(symbol)) {
+        return find(*id);
+    }
+
+    return nullptr;
+}
+
+const ContractRules *ContractIndex::find(const SymbolId symbolId) const {
+    if (symbolId < m_p->rules.size() && m_p->rules[symbolId]) {
+        return &*m_p->rules[symbolId];
+    }
+
+    return nullptr;
+}
+
+std::size_t ContractIndex::size() const {
+    return m_p->count;
+}
+
+std::optional<std::string> ContractIndex::validate(const OrderRequest &request) const {
+    const auto *rules = find(request.symbol);
+
+    if (!rules) {
+        return fmt::format("Unknown contract: {}", request.symbol);
+    }
+
+    if (!rules->isTradable()) {
+        return fmt::format("Contract {} is not tradable", request.symbol);
+    }
+
+    if (request.vol < rules->minVol || request.vol > rules->maxVol) {
+        return fmt::format("Volume {} of {} is out of range {} - {}", request.vol, request.symbol, rules->minVol,
+                           rules->maxVol);
+    }
+
+    if (!rules->isVolumeOnStep(request.vol)) {
+        return fmt::format("Volume {} of {} is not a multiple of {}", request.vol, request.symbol, rules->volUnit);
+    }
+
+    if (hasPrice(request.type) && (request.price <= 0.0 || !rules->isPriceOnTick(request.price))) {
+        return fmt::format("Price {} of {} is not a positive multiple of {}", request.price, request.symbol,
+                           rules->priceUnit);
+    }
+
+    for (const auto price: {request.stopLossPrice, request.takeProfitPrice}) {
+        if (price != 0.0 && !rules->isPriceOnTick(price)) {
+            return fmt::format("Trigger price {} of {} is not a multiple of {}", price, request.symbol,
+                               rules->priceUnit);
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool ContractIndex::normalize(OrderRequest &request) const {
+    const auto *rules = find(request.symbol);
+
+    if (!rules) {
+        return false;
+    }
+
+    request.vol = rules->roundVolume(request.vol);
+
+    if (hasPrice(request.type)) {
+        request.price = rules->roundPrice(request.price);
+    }
+
+    if (request.stopLossPrice != 0.0) {
+        request.stopLossPrice = rules->roundPrice(request.stopLossPrice);
+    }
+
+    if (request.takeProfitPrice != 0.0) {
+        request.takeProfitPrice = rules->roundPrice(request.takeProfitPrice);
+    }
+
+    return true;
+}
+}
@@ -9,8 +9,37 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include "vk/mexc/mexc_event_models.h"
 #include "vk/utils/utils.h"
 #include "vk/utils/json_utils.h"
+#include "vk/mexc/mexc_json_fields.h"
 
 namespace vk::mexc::futures {
+namespace {
+constexpr auto EVENT_TICKER_FIELDS = makeJsonFieldTable<EventTicker>(
+	jsonField<&EventTicker::symbol>("symbol"),
+	jsonField<&EventTicker::bid1>("bid1"),
+	jsonField<&EventTicker::ask1>("ask1"),
+	jsonField<&EventTicker::volume24>("volume24"),
+	jsonField<&EventTicker::holdVol>("holdVol"),
+	jsonField<&EventTicker::lower24Price>("lower24Price"),
+	jsonField<&EventTicker::high24Price>("high24Price"),
+	jsonField<&EventTicker::riseFallRate>("riseFallRate"),
+	jsonField<&EventTicker::riseFallValue>("riseFallValue"),
+	jsonField<&EventTicker::indexPrice>("indexPrice"),
+	jsonField<&EventTicker::fairPrice>("fairPrice"),
+	jsonField<&EventTicker::fundingRate>("fundingRate"),
+	jsonField<&EventTicker::timestamp>("timestamp"));
+
+constexpr auto EVENT_CANDLESTICK_FIELDS = makeJsonFieldTable<EventCandlestick>(
+	jsonField<&EventCandlestick::symbol>("symbol"),
+	jsonField<&EventCandlestick::amount>("a"),
+	jsonField<&EventCandlestick::interval>("interval"),
+	jsonField<&EventCandlestick::open>("o"),
+	jsonField<&EventCandlestick::high>("h"),
+	jsonField<&EventCandlestick::low>("l"),
+	jsonField<&EventCandlestick::close>("c"),
+	jsonField<&EventCandlestick::volume>("q"),
+	jsonField<&EventCandlestick::start>("t"));
+}
+
 nlohmann::json WSSubscriptionParameters::toJson() const {
 	nlohmann::json result;
 	result["symbol"] = symbol;
@@ -50,10 +79,45 @@ nlohmann::json Event::toJson() const {
 }
 
 void Event::fromJson(const nlohmann::json &json) {
-	readValue<std::string>(json, "channel", channel);
-	readValue<std::string>(json, "symbol", symbol);
-	readValue<std::int64_t>(json, "ts", ts);
-	data = json["data"];
+	static constexpr auto FIELDS = makeJsonFieldTable<Event>(
+		jsonField<&Event::channel>("channel"),
+		jsonField<&Event::symbol>("symbol"),
+		jsonField<&Event::ts>("ts"),
+		jsonField<&Event::data>("data"));
+	FIELDS.read(json, *this);
+
+	if (!symbol.empty()) {
+		symbolId = SymbolRegistry::instance().intern(symbol);
+	}
+}
+
+bool EventFrame::scan(const std::string_view frame) {
+	JsonScanner scanner(frame);
+
+	if (scanner.peek() != '{') {
+		return false;
+	}
+
+	text = frame;
+	scanner.readObject([&](const std::string_view key) {
+		if (scanner.readNull()) {
+			return;
+		}
+
+		if (key == "channel") {
+			channel = scanner.readString();
+		} else if (key == "symbol") {
+			symbol = scanner.readString();
+		} else if (key == "ts") {
+			ts = scanner.readInt();
+		} else if (key == "data") {
+			data = scanner.skipValue();
+		} else {
+			scanner.skipValue();
+		}
+	});
+
+	return true;
 }
 
 nlohmann::json EventTicker::toJson() const {
@@ -61,19 +125,19 @@ nlohmann::json EventTicker::toJson() const {
 }
 
 void EventTicker::fromJson(const nlohmann::json &json) {
-	readValue<std::string>(json, "symbol", symbol);
-	readValue<double>(json, "bid1", bid1);
-	readValue<double>(json, "ask1", ask1);
-	readValue<double>(json, "volume24", volume24);
-	readValue<double>(json, "holdVol", holdVol);
-	readValue<double>(json, "lower24Price", lower24Price);
-	readValue<double>(json, "high24Price", high24Price);
-	readValue<double>(json, "riseFallRate", riseFallRate);
-	readValue<double>(json, "riseFallValue", riseFallValue);
-	readValue<double>(json, "indexPrice", indexPrice);
-	readValue<double>(json, "fairPrice", fairPrice);
-	readValue<double>(json, "fundingRate", fundingRate);
-	readValue<std::int64_t>(json, "m_timestamp", timestamp);
+	EVENT_TICKER_FIELDS.read(json, *this);
+
+	if (!symbol.empty()) {
+		symbolId = SymbolRegistry::instance().intern(symbol);
+	}
+}
+
+void EventTicker::fromJson(JsonScanner &scanner) {
+	EVENT_TICKER_FIELDS.scan(scanner, *this);
+
+	if (!symbol.empty()) {
+		symbolId = SymbolRegistry::instance().intern(symbol);
+	}
 }
 
 nlohmann::json EventCandlestick::toJson() const {
@@ -81,14 +145,49 @@ nlohmann::json EventCandlestick::toJson() const {
 }
 
 void EventCandlestick::fromJson(const nlohmann::json &json) {
-	readValue<std::string>(json, "symbol", symbol);
-	readValue<double>(json, "a", amount);
-	readMagicEnum<CandleInterval>(json, "interval", interval);
-	readValue<double>(json, "o", open);
-	readValue<double>(json, "h", high);
-	readValue<double>(json, "l", low);
-	readValue<double>(json, "c", close);
-	readValue<double>(json, "q", volume);
-	readValue<std::int64_t>(json, "t", start);
+	EVENT_CANDLESTICK_FIELDS.read(json, *this);
+
+	if (!symbol.empty()) {
+		symbolId = SymbolRegistry::instance().intern(symbol);
+	}
+}
+
+nlohmann::json EventDepth::toJson() const {
+	throw std::runtime_error("Unimplemented: EventDepth::toJson()");
+}
+
+void EventDepth::fromJson(const nlohmann::json &json) {
+	const auto dump = json.dump();
+	JsonScanner scanner(dump);
+	fromJson(scanner);
+}
+
+void EventDepth::fromJson(JsonScanner &scanner) {
+	scanner.readObject([&](const std::string_view key) {
+		if (scanner.readNull()) {
+			return;
+		}
+
+		if (key == "asks") {
+			readDepthLevels(scanner, asks);
+		} else if (key == "bids") {
+			readDepthLevels(scanner, bids);
+		} else if (key == "version") {
+			version = scanner.readInt();
+		} else if (key == "symbol") {
+			symbol = scanner.readString();
+			symbolId = SymbolRegistry::instance().intern(symbol);
+		} else {
+			scanner.skipValue();
+		}
+	});
+}
+
+void EventCandlestick::fromJson(JsonScanner &scanner) {
+	EVENT_CANDLESTICK_FIELDS.scan(scanner, *this);
+
+	if (!symbol.empty()) {
+		symbolId = SymbolRegistry::instance().intern(symbol);
+	}
 }
 }
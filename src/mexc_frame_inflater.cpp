@@ -0,0 +1,170 @@
+/**
+MEXC Compressed Frame Inflater
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_frame_inflater.h"
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace vk::mexc {
+namespace {
+constexpr std::size_t MIN_OUTPUT_SIZE = 16 * 1024;
+/// Size hints of the headers above it are not trusted for preallocation
+constexpr std::size_t MAX_SIZE_HINT = 16 * 1024 * 1024;
+
+constexpr std::uint8_t GZIP_FHCRC = 0x02;
+constexpr std::uint8_t GZIP_FEXTRA = 0x04;
+constexpr std::uint8_t GZIP_FNAME = 0x08;
+constexpr std::uint8_t GZIP_FCOMMENT = 0x10;
+
+std::uint8_t byteAt(const std::string_view data, const std::size_t pos) {
+    if (pos >= data.size()) {
+        throw std::runtime_error("Truncated compressed frame header");
+    }
+
+    return static_cast<std::uint8_t>(data[pos]);
+}
+
+struct Deflated {
+    /// Deflate data, for gzip and zlib followed by the trailer
+    std::string_view body;
+    /// Size of the inflated data modulo 2^32 if the format carries it, 0 otherwise
+    std::size_t sizeHint{};
+    /// Gzip and zlib data always end with the final block, raw deflate data may end with a sync flush
+    bool isFramed{};
+};
+
+/**
+ * Strip the gzip (RFC 1952) or zlib (RFC 1950) header, anything else is taken as raw deflate. The trailer stays in the
+ * input, the inflater looks ahead a full Huffman table index past the final block code and stops at the end of the
+ * stream without consuming it. Data ending right after that code would never reach the end of the stream.
+ */
+Deflated stripHeader(const std::string_view payload) {
+    if (payload.size() >= 18 && byteAt(payload, 0) == 0x1F && byteAt(payload, 1) == 0x8B) {
+        if (byteAt(payload, 2) != 8) {
+            throw std::runtime_error("Unsupported gzip compression method");
+        }
+
+        const auto flags = byteAt(payload, 3);
+        std::size_t pos = 10;
+
+        if (flags & GZIP_FEXTRA) {
+            pos += 2 + (byteAt(payload, pos) | byteAt(payload, pos + 1) << 8);
+        }
+
+        for (const auto flag: {GZIP_FNAME, GZIP_FCOMMENT}) {
+            if (flags & flag) {
+                while (byteAt(payload, pos++) != 0) {
+                }
+            }
+        }
+
+        if (flags & GZIP_FHCRC) {
+            pos += 2;
+        }
+
+        if (pos + 8 > payload.size()) {
+            throw std::runtime_error("Truncated gzip frame");
+        }
+
+        /// ISIZE, little endian size of the inflated data modulo 2^32
+        const auto end = payload.size() - 4;
+        const std::size_t size = byteAt(payload, end) | byteAt(payload, end + 1) << 8 |
+                                 byteAt(payload, end + 2) << 16 | static_cast<std::size_t>(byteAt(payload, end + 3)) << 24;
+        return {payload.substr(pos), size, true};
+    }
+
+    if (payload.size() >= 6 && (byteAt(payload, 0) & 0x0F) == 8 &&
+        (byteAt(payload, 0) << 8 | byteAt(payload, 1)) % 31 == 0) {
+        if (byteAt(payload, 1) & 0x20) {
+            throw std::runtime_error("Unsupported zlib preset dictionary");
+        }
+
+        return {payload.substr(2), 0, true};
+    }
+
+    return {payload};
+}
+}
+
+struct FrameInflater::P {
+    boost::beast::zlib::inflate_stream stream;
+    std::vector<char> output;
+    InflaterStats stats;
+};
+
+FrameInflater::FrameInflater() : m_p(std::make_unique<P>()) {
+}
+
+FrameInflater::~FrameInflater() = default;
+
+std::string_view FrameInflater::inflate(const std::string_view payload) {
+    const auto [body, sizeHint, isFramed] = stripHeader(payload);
+
+    /// One byte more than the hint, the end of the stream is detected without growing the buffer
+    if (const auto size = std::max(std::min(sizeHint, MAX_SIZE_HINT) + 1, MIN_OUTPUT_SIZE); m_p->output.size() < size) {
+        m_p->output.resize(size);
+    }
+
+    /// Keeps the window and the tables allocated by the previous frames
+    m_p->stream.reset();
+
+    boost::beast::zlib::z_params params;
+    params.next_in = body.data();
+    params.avail_in = body.size();
+    std::size_t produced = 0;
+    bool isComplete = false;
+
+    for (;;) {
+        if (produced == m_p->output.size()) {
+            m_p->output.resize(m_p->output.size() * 2);
+        }
+
+        params.next_out = m_p->output.data() + produced;
+        params.avail_out = m_p->output.size() - produced;
+
+        boost::beast::error_code ec;
+        m_p->stream.write(params, boost::beast::zlib::Flush::sync, ec);
+        produced = m_p->output.size() - params.avail_out;
+
+        if (ec == boost::beast::zlib::error::end_of_stream) {
+            isComplete = true;
+            break;
+        }
+
+        if (ec && ec != boost::beast::zlib::error::need_buffers) {
+            throw std::runtime_error("Corrupted compressed frame: " + ec.message());
+        }
+
+        if (params.avail_out > 0) {
+            if (params.avail_in == 0) {
+                /// All input consumed, the data ended by a sync flush without the final block
+                break;
+            }
+
+            if (ec) {
+                throw std::runtime_error("Corrupted compressed frame");
+            }
+        }
+    }
+
+    if (isFramed && (!isComplete || (sizeHint != 0 && sizeHint != (produced & 0xFFFFFFFFu)))) {
+        throw std::runtime_error("Truncated compressed frame");
+    }
+
+    ++m_p->stats.frames;
+    m_p->stats.compressedBytes += static_cast<std::int64_t>(payload.size());
+    m_p->stats.inflatedBytes += static_cast<std::int64_t>(produced);
+    return {m_p->output.data(), produced};
+}
+
+InflaterStats FrameInflater::stats() const {
+    return m_p->stats;
+}
+}
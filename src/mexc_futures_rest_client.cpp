@@ -8,14 +8,18 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 
 #include "vk/mexc/mexc_futures_rest_client.h"
 #include "vk/mexc/mexc_http_futures_session.h"
+#include "vk/mexc/mexc_request_coalescer.h"
+#include "vk/mexc/mexc_retry_policy.h"
 #include <spdlog/fmt/ostr.h>
 #include <algorithm>
 #include <deque>
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <future>
 
 namespace vk::mexc::futures {
+static constexpr std::size_t MAX_ORDERS_PER_REQUEST = 50;
 
 struct RateLimiter {
     std::mutex mutex;
@@ -51,21 +55,36 @@ struct RateLimiter {
 };
 
 template <typename ValueType>
-ValueType handleMEXCResponse(const http::response<http::string_body>& response) {
-    ValueType retVal;
-    retVal.fromJson(nlohmann::json::parse(response.body()));
+void handleMEXCResponse(const http::response<http::string_body>& response, ValueType& retVal) {
+    // Models which can decode the text directly get the number tokens as sent, not rounded to double
+    if constexpr (requires(JsonScanner &scanner) { retVal.fromJson(scanner); }) {
+        JsonScanner scanner(response.body());
+        retVal.fromJson(scanner);
+    } else {
+        retVal.fromJson(nlohmann::json::parse(response.body()));
+    }
 
     if (!retVal.success) {
         throw std::runtime_error(
             fmt::format("MEXC API error, code: {}", retVal.code).c_str());
     }
+}
 
+template <typename ValueType>
+ValueType handleMEXCResponse(const http::response<http::string_body>& response) {
+    ValueType retVal;
+    handleMEXCResponse(response, retVal);
     return retVal;
 }
 struct RESTClient::P {
     RESTClient *parent = nullptr;
     std::shared_ptr<HTTPSession> httpSession;
     mutable RateLimiter rateLimiter;
+    RequestCoalescer coalescer;
+    RetryPolicy retryPolicy;
+    std::shared_ptr<ClockSync> clockSync = std::make_shared<ClockSync>();
+    std::shared_ptr<const ContractIndex> contractIndex;
+    int receiveWindow = 25000;
 
     static http::response<http::string_body> checkResponse(const http::response<http::string_body>& response) {
         if (response.result() != http::status::ok) {
@@ -79,41 +98,149 @@ struct RESTClient::P {
         this->parent = parent;
     }
 
-    [[nodiscard]] std::vector<Candle>
-    getHistoricalPrices(const std::string &symbol, CandleInterval interval, std::int64_t startTime,
-                        std::int64_t endTime) const {
+    template<typename... Args>
+    void createSession(Args &&... args) {
+        httpSession = std::make_shared<HTTPSession>(std::forward<Args>(args)...);
+        httpSession->setClockSync(clockSync);
+        httpSession->setReceiveWindow(receiveWindow);
+    }
+
+    /**
+     * Public GET request, identical concurrent requests are coalesced into one, failures are retried by the policy
+     * @param route path with its parameters as placeholders, e.g. /api/v1/contract/depth/{symbol}, it keys the
+     * circuit breaker so all symbols of an endpoint share one, empty if the path has no parameters
+     */
+    [[nodiscard]] http::response<http::string_body> publicGet(const std::string &path,
+                                                              const std::map<std::string, std::string> &parameters,
+                                                              const std::string &route = {}) const {
+        return coalescer.run(RequestCoalescer::makeKey(path, parameters), [&] {
+            return checkResponse(retryPolicy.run(route.empty() ? path : route, [&] {
+                rateLimiter.wait();
+                return httpSession->methodGet(path, parameters);
+            }));
+        });
+    }
+
+    [[nodiscard]] http::response<http::string_body> getKlines(const std::string &symbol, CandleInterval interval,
+                                                              std::int64_t startTime, std::int64_t endTime) const {
         const std::string path = "/api/v1/contract/kline/" + symbol;
         std::map<std::string, std::string> parameters;
         parameters.insert_or_assign("interval", std::string(magic_enum::enum_name(interval)));
         parameters.insert_or_assign("start", std::to_string(startTime));
         parameters.insert_or_assign("end", std::to_string(endTime));
 
-        rateLimiter.wait();
-        const auto response = checkResponse(httpSession->methodGet(path, parameters));
-        return handleMEXCResponse<Candles>(response).candles;
+        return publicGet(path, parameters, "/api/v1/contract/kline/{symbol}");
+    }
+
+    [[nodiscard]] std::vector<Candle>
+    getHistoricalPrices(const std::string &symbol, CandleInterval interval, std::int64_t startTime,
+                        std::int64_t endTime) const {
+        return handleMEXCResponse<Candles>(getKlines(symbol, interval, startTime, endTime)).candles;
+    }
+
+    [[nodiscard]] CandleColumns
+    getHistoricalColumns(const std::string &symbol, CandleInterval interval, std::int64_t startTime,
+                         std::int64_t endTime) const {
+        const auto response = handleMEXCResponse<Response>(getKlines(symbol, interval, startTime, endTime));
+        return CandleColumns::fromFuturesJson(response.data);
+    }
+
+    /**
+     * Split items into chunks of at most MAX_ORDERS_PER_REQUEST and POST them concurrently, per-item results of all
+     * chunks are merged into one response. A failed chunk does not throw, its items are reported with an error code.
+     * @param path endpoint path
+     * @param items order requests or order IDs
+     * @param toJson converts item to its JSON body representation
+     * @param failedResult creates per-item result for an item of a failed chunk
+     */
+    template<typename ValueType, typename Item, typename ToJson, typename FailedResult>
+    [[nodiscard]] ValueType postChunked(const std::string &path, const std::vector<Item> &items, const ToJson &toJson,
+                                       const FailedResult &failedResult) const {
+        std::vector<std::future<ValueType>> chunkResponses;
+
+        for (std::size_t begin = 0; begin < items.size(); begin += MAX_ORDERS_PER_REQUEST) {
+            const auto end = std::min(items.size(), begin + MAX_ORDERS_PER_REQUEST);
+            std::vector<Item> chunk(items.begin() + static_cast<std::ptrdiff_t>(begin),
+                                    items.begin() + static_cast<std::ptrdiff_t>(end));
+
+            chunkResponses.push_back(std::async(std::launch::async, [this, &path, &toJson, &failedResult, chunk] {
+                nlohmann::json body = nlohmann::json::array();
+
+                for (const auto &item: chunk) {
+                    body.push_back(toJson(item));
+                }
+
+                ValueType chunkResponse;
+
+                try {
+                    rateLimiter.wait();
+                    // dump(-1) produces compact JSON (no whitespace) — critical for MD5 signing
+                    const auto response = checkResponse(httpSession->methodPost(path, body.dump(-1)));
+                    chunkResponse.fromJson(nlohmann::json::parse(response.body()));
+
+                    if (!chunkResponse.success && chunkResponse.results.empty()) {
+                        const auto message = fmt::format("MEXC API error, code: {}", chunkResponse.code);
+
+                        for (const auto &item: chunk) {
+                            chunkResponse.results.push_back(failedResult(item, chunkResponse.code, message));
+                        }
+                    }
+                } catch (std::exception &e) {
+                    chunkResponse.success = false;
+                    chunkResponse.code = -1;
+                    chunkResponse.results.clear();
+
+                    for (const auto &item: chunk) {
+                        chunkResponse.results.push_back(failedResult(item, -1, e.what()));
+                    }
+                }
+
+                return chunkResponse;
+            }));
+        }
+
+        ValueType retVal;
+        retVal.success = true;
+
+        for (auto &chunkResponse: chunkResponses) {
+            auto response = chunkResponse.get();
+
+            if (!response.success) {
+                retVal.success = false;
+
+                if (retVal.code == 0) {
+                    retVal.code = response.code;
+                }
+            }
+
+            retVal.results.insert(retVal.results.end(), std::make_move_iterator(response.results.begin()),
+                                  std::make_move_iterator(response.results.end()));
+        }
+
+        return retVal;
     }
 };
 
 RESTClient::RESTClient(const std::string &apiKey, const std::string &apiSecret) : m_p(
     std::make_unique<P>(this)) {
-    m_p->httpSession = std::make_shared<HTTPSession>(apiKey, apiSecret);
+    m_p->createSession(apiKey, apiSecret);
 }
 
 RESTClient::RESTClient(const std::string &webToken, const AuthSource source) : m_p(
     std::make_unique<P>(this)) {
-    m_p->httpSession = std::make_shared<HTTPSession>(webToken, source);
+    m_p->createSession(webToken, source);
 }
 
 RESTClient::~RESTClient() = default;
 
 void RESTClient::setCredentials(const std::string &apiKey, const std::string &apiSecret) const {
     m_p->httpSession.reset();
-    m_p->httpSession = std::make_shared<HTTPSession>(apiKey, apiSecret);
+    m_p->createSession(apiKey, apiSecret);
 }
 
 void RESTClient::setWebToken(const std::string &webToken) const {
     m_p->httpSession.reset();
-    m_p->httpSession = std::make_shared<HTTPSession>(webToken, AuthSource::Web);
+    m_p->createSession(webToken, AuthSource::Web);
 }
 
 std::int64_t RESTClient::getServerTime() const {
@@ -123,6 +250,29 @@ std::int64_t RESTClient::getServerTime() const {
     return handleMEXCResponse<ServerTime>(response).serverTime;
 }
 
+std::int64_t RESTClient::synchronizeClock(const int samples) const {
+    const std::string path = "/api/v1/contract/ping";
+
+    for (int i = 0; i < samples; ++i) {
+        std::int64_t requestTime = 0;
+        std::int64_t responseTime = 0;
+        m_p->rateLimiter.wait();
+        const auto response = P::checkResponse(m_p->httpSession->methodGetTimed(path, requestTime, responseTime));
+        m_p->clockSync->addSample(requestTime, handleMEXCResponse<ServerTime>(response).serverTime, responseTime);
+    }
+
+    return m_p->clockSync->offset();
+}
+
+const ClockSync &RESTClient::clockSync() const {
+    return *m_p->clockSync;
+}
+
+void RESTClient::setReceiveWindow(const int receiveWindow) const {
+    m_p->receiveWindow = receiveWindow;
+    m_p->httpSession->setReceiveWindow(receiveWindow);
+}
+
 std::vector<ContractDetail> RESTClient::getContractDetails(const std::string &symbol) const {
     std::string path = "/api/v1/contract/detail";
     std::map<std::string, std::string> parameters;
@@ -131,22 +281,49 @@ std::vector<ContractDetail> RESTClient::getContractDetails(const std::string &sy
         parameters.insert_or_assign("symbol", symbol);
     }
 
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path, parameters));
+    const auto response = m_p->publicGet(path, parameters);
     return handleMEXCResponse<ContractDetails>(response).contractDetails;
 }
 
+void RESTClient::getContractDetails(PmrContractDetails &result, const std::string &symbol) const {
+    std::string path = "/api/v1/contract/detail";
+    std::map<std::string, std::string> parameters;
+
+    if (!symbol.empty()) {
+        parameters.insert_or_assign("symbol", symbol);
+    }
+
+    const auto response = m_p->publicGet(path, parameters);
+    handleMEXCResponse(response, result);
+}
+
+ContractDetailsView RESTClient::getContractDetailsView(const std::string &symbol) const {
+    std::string path = "/api/v1/contract/detail";
+    std::map<std::string, std::string> parameters;
+
+    if (!symbol.empty()) {
+        parameters.insert_or_assign("symbol", symbol);
+    }
+
+    auto response = m_p->publicGet(path, parameters);
+    ContractDetailsView retVal(std::move(response.body()));
+
+    if (!retVal.success()) {
+        throw std::runtime_error(fmt::format("MEXC API error, code: {}", retVal.code()).c_str());
+    }
+
+    return retVal;
+}
+
 FundingRate RESTClient::getContractFundingRate(const std::string &contract) const {
     const std::string path = "/api/v1/contract/funding_rate/" + contract;
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path,{}));
+    const auto response = m_p->publicGet(path, {}, "/api/v1/contract/funding_rate/{symbol}");
     return handleMEXCResponse<FundingRate>(response);
 }
 
 std::vector<FundingRate> RESTClient::getContractFundingRates() const {
     const std::string path = "/api/v1/contract/funding_rate";
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path,{}));
+    const auto response = m_p->publicGet(path, {});
     return handleMEXCResponse<FundingRates>(response).fundingRates;
 }
 
@@ -159,8 +336,7 @@ HistoricalFundingRates RESTClient::getContractFundingRateHistory(const std::stri
     parameters.insert_or_assign("page_num", std::to_string(pageNum));
     parameters.insert_or_assign("page_size", std::to_string(pageSize));
 
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path, parameters));
+    const auto response = m_p->publicGet(path, parameters);
     return handleMEXCResponse<HistoricalFundingRates>(response);
 }
 
@@ -176,11 +352,22 @@ Ticker RESTClient::getContractTicker(const std::string &symbol) const {
     std::map<std::string, std::string> parameters;
     parameters.insert_or_assign("symbol", symbol);
 
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path, parameters));
+    const auto response = m_p->publicGet(path, parameters);
     return handleMEXCResponse<Ticker>(response);
 }
 
+Depth RESTClient::getContractDepth(const std::string &symbol, const std::int32_t limit) const {
+    const std::string path = "/api/v1/contract/depth/" + symbol;
+    std::map<std::string, std::string> parameters;
+
+    if (limit > 0) {
+        parameters.insert_or_assign("limit", std::to_string(limit));
+    }
+
+    const auto response = m_p->publicGet(path, parameters, "/api/v1/contract/depth/{symbol}");
+    return handleMEXCResponse<Depth>(response);
+}
+
 std::vector<OpenPosition> RESTClient::getOpenPositions(const std::string &symbol) const {
     std::string path = "/api/v1/private/position/open_positions";
     std::map<std::string, std::string> parameters;
@@ -194,8 +381,19 @@ std::vector<OpenPosition> RESTClient::getOpenPositions(const std::string &symbol
     return handleMEXCResponse<OpenPositions>(response).positions;
 }
 
+void RESTClient::setContractIndex(const std::shared_ptr<const ContractIndex> &contractIndex) const {
+    m_p->contractIndex = contractIndex;
+}
+
 OrderResponse RESTClient::submitOrder(const OrderRequest &request) const {
     const std::string path = "/api/v1/private/order/submit";
+
+    if (m_p->contractIndex) {
+        if (const auto error = m_p->contractIndex->validate(request)) {
+            throw std::runtime_error(fmt::format("Invalid order: {}", *error).c_str());
+        }
+    }
+
     // dump(-1) produces compact JSON (no whitespace) — critical for MD5 signing
     const std::string jsonBody = request.toJson().dump(-1);
 
@@ -204,14 +402,74 @@ OrderResponse RESTClient::submitOrder(const OrderRequest &request) const {
     return handleMEXCResponse<OrderResponse>(response);
 }
 
+BatchOrderResponse RESTClient::submitOrders(const std::vector<OrderRequest> &requests) const {
+    const std::string path = "/api/v1/private/order/submit_batch";
+    const auto failedResult = [](const OrderRequest &request, const std::int32_t errorCode,
+                                 const std::string &errorMsg) {
+        BatchOrderResponse::Result result;
+        result.externalOid = request.externalOid;
+        result.errorCode = errorCode;
+        result.errorMsg = errorMsg;
+        return result;
+    };
+
+    if (!m_p->contractIndex) {
+        return m_p->postChunked<BatchOrderResponse>(
+            path, requests, [](const OrderRequest &request) { return request.toJson(); }, failedResult);
+    }
+
+    std::vector<OrderRequest> validRequests;
+    std::vector<BatchOrderResponse::Result> rejected;
+    validRequests.reserve(requests.size());
+
+    for (const auto &request: requests) {
+        if (const auto error = m_p->contractIndex->validate(request)) {
+            rejected.push_back(failedResult(request, -2, *error));
+        } else {
+            validRequests.push_back(request);
+        }
+    }
+
+    auto retVal = m_p->postChunked<BatchOrderResponse>(
+        path, validRequests, [](const OrderRequest &request) { return request.toJson(); }, failedResult);
+
+    if (!rejected.empty()) {
+        retVal.success = false;
+
+        if (retVal.code == 0) {
+            retVal.code = -2;
+        }
+
+        retVal.results.insert(retVal.results.end(), rejected.begin(), rejected.end());
+    }
+
+    return retVal;
+}
+
 CancelOrderResponse RESTClient::cancelOrders(const std::vector<std::int64_t> &orderIds) const {
     const std::string path = "/api/v1/private/order/cancel";
-    const nlohmann::json body = orderIds;
-    const std::string jsonBody = body.dump(-1);
 
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodPost(path, jsonBody));
-    return handleMEXCResponse<CancelOrderResponse>(response);
+    return m_p->postChunked<CancelOrderResponse>(
+        path, orderIds, [](const std::int64_t orderId) { return nlohmann::json(orderId); },
+        [](const std::int64_t orderId, const std::int32_t errorCode, const std::string &errorMsg) {
+            CancelOrderResponse::Result result;
+            result.orderId = orderId;
+            result.errorCode = errorCode;
+            result.errorMsg = errorMsg;
+            return result;
+        });
+}
+
+std::int64_t RESTClient::coalescedRequestsCount() const {
+    return m_p->coalescer.coalescedCount();
+}
+
+void RESTClient::setRetrySettings(const RetrySettings &settings) const {
+    m_p->retryPolicy.setSettings(settings);
+}
+
+RetryStats RESTClient::retryStats() const {
+    return m_p->retryPolicy.stats();
 }
 
 std::vector<Candle> RESTClient::getHistoricalPrices(const std::string &symbol, const CandleInterval interval,
@@ -261,4 +519,28 @@ std::vector<Candle> RESTClient::getHistoricalPrices(const std::string &symbol, c
 
     return retVal;
 }
+CandleColumns RESTClient::getHistoricalCandleColumns(const std::string &symbol, const CandleInterval interval,
+                                                     const std::int64_t startTime, const std::int64_t endTime) const {
+    CandleColumns retVal;
+    std::int64_t currentEndTime = endTime;
+
+    while (startTime < currentEndTime) {
+        const auto candles = m_p->getHistoricalColumns(symbol, interval, startTime, currentEndTime);
+
+        if (candles.empty()) {
+            break;
+        }
+
+        // Batches arrive newest first, each of them in chronological order
+        retVal.prepend(candles);
+        currentEndTime = candles.openTime.front() / 1000 - 1;
+    }
+
+    // Remove the newest candle as it might be incomplete
+    if (!retVal.empty()) {
+        retVal.pop_back();
+    }
+
+    return retVal;
+}
 }
@@ -9,75 +9,450 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include "vk/mexc/mexc_futures_ws_client.h"
 
 #include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <thread>
+#include <utility>
 
 namespace vk::mexc::futures {
 static auto MEXC_FUTURES_WS_HOST = "contract.mexc.com";
 static auto MEXC_FUTURES_WS_PORT = "443";
 
+namespace {
+/// IO context with its thread, the connections are distributed over the workers round-robin
+struct IoWorker {
+    boost::asio::io_context ioContext;
+    std::thread ioThread;
+    std::atomic<bool> isRunning = false;
+};
+
+/// One connection and the subscriptions assigned to it
+struct Shard {
+    std::size_t index{};
+    IoWorker &worker;
+    std::weak_ptr<WebSocketSession> session;
+    /// Assigned subscriptions, replayed by the next connection attempt when the connection is lost
+    std::vector<nlohmann::json> subscriptions;
+    boost::asio::steady_timer reconnectTimer;
+    /// Last frame received before the connection was lost, set while reconnecting
+    std::optional<std::chrono::system_clock::time_point> gapStart;
+    int attempts{};
+
+    Shard(const std::size_t index, IoWorker &worker) : index(index), worker(worker), reconnectTimer(worker.ioContext) {
+    }
+
+    [[nodiscard]] bool contains(const nlohmann::json &subscriptionRequest) const {
+        return std::ranges::find(subscriptions, subscriptionRequest) != subscriptions.end();
+    }
+};
+
+/// Consumer queues of one event type, replaced as a whole by add, so deliver iterates a snapshot without locking
+template<typename T>
+class EventQueues {
+    using Queues = std::vector<std::shared_ptr<EventQueue<T>>>;
+    std::atomic<std::shared_ptr<const Queues>> m_queues{std::make_shared<const Queues>()};
+
+public:
+    /// The writers must be serialized, copy on write keeps the snapshots being iterated intact
+    std::shared_ptr<EventQueue<T>> add(const EventQueueSettings &settings) {
+        auto queues = std::make_shared<Queues>(*m_queues.load(std::memory_order_acquire));
+        auto retVal = queues->emplace_back(std::make_shared<EventQueue<T>>(settings));
+        m_queues.store(std::move(queues), std::memory_order_release);
+        return retVal;
+    }
+
+    /// Each queue but the last gets a copy, the event is moved into the last one
+    void deliver(T &&event) const {
+        const auto queues = m_queues.load(std::memory_order_acquire);
+
+        if (queues->empty()) {
+            return;
+        }
+
+        for (std::size_t i = 0; i + 1 < queues->size(); ++i) {
+            (*queues)[i]->push(std::as_const(event));
+        }
+
+        queues->back()->push(std::move(event));
+    }
+
+    void close() const {
+        for (const auto &queue: *m_queues.load(std::memory_order_acquire)) {
+            queue->close();
+        }
+    }
+};
+
+/// Callback and queues of a channel decoded into typed events
+template<typename T>
+struct TypedChannel {
+    std::function<void(const T &)> callback;
+    EventQueues<T> queues;
+
+    void deliver(T &&event) const {
+        if (callback) {
+            callback(event);
+        }
+
+        queues.deliver(std::move(event));
+    }
+};
+
+EventTicker decodeTicker(const EventFrame &eventFrame) {
+    JsonScanner scanner(eventFrame.data);
+    EventTicker retVal;
+    retVal.fromJson(scanner);
+    return retVal;
+}
+
+EventCandlestick decodeCandlestick(const EventFrame &eventFrame) {
+    JsonScanner scanner(eventFrame.data);
+    EventCandlestick retVal;
+    retVal.fromJson(scanner);
+
+    if (retVal.symbol.empty() && !eventFrame.symbol.empty()) {
+        retVal.symbol = eventFrame.symbol;
+        retVal.symbolId = SymbolRegistry::instance().intern(eventFrame.symbol);
+    }
+
+    return retVal;
+}
+
+EventDepth decodeDepth(const EventFrame &eventFrame, const bool isSnapshot) {
+    JsonScanner scanner(eventFrame.data);
+    EventDepth retVal;
+    retVal.fromJson(scanner);
+    retVal.isSnapshot = isSnapshot;
+    retVal.ts = eventFrame.ts;
+
+    if (retVal.symbol.empty() && !eventFrame.symbol.empty()) {
+        retVal.symbol = eventFrame.symbol;
+        retVal.symbolId = SymbolRegistry::instance().intern(eventFrame.symbol);
+    }
+
+    return retVal;
+}
+}
+
 struct WSClient::P {
-    boost::asio::io_context m_ioContext;
     boost::asio::ssl::context m_ctx;
     std::string m_host = {MEXC_FUTURES_WS_HOST};
     std::string m_port = {MEXC_FUTURES_WS_PORT};
-    std::weak_ptr<WebSocketSession> m_session;
-    std::thread m_ioThread;
-    std::atomic<bool> m_isRunning = false;
     onLogMessage m_logMessageCB;
     onDataEvent m_dataEventCB;
+    /// Added to under m_sessionLocker
+    EventQueues<Event> m_eventQueues;
+    /// Guarded by m_sessionLocker, it cannot change after the first subscription
+    ChannelRegistry m_channels;
+    /// Set with their channel handlers, before the first subscription
+    TypedChannel<EventTicker> m_tickers;
+    TypedChannel<EventCandlestick> m_candlesticks;
+    TypedChannel<EventDepth> m_depths;
+    ReconnectSettings m_reconnectSettings;
+    ShardingSettings m_shardingSettings;
+    bool m_permessageDeflate{false};
+    onStreamGap m_streamGapCB;
+    onConnectionLost m_connectionLostCB;
+    std::atomic<bool> m_isClosing = false;
+
+    /// Guards the workers, the shards and their state, the sessions call back from the IO threads
+    mutable std::mutex m_sessionLocker;
+    /// Declared before the shards, their timers must be destroyed before the IO contexts
+    std::vector<std::unique_ptr<IoWorker>> m_workers;
+    /// Shards are never removed, the callbacks of their sessions refer to them
+    std::vector<std::unique_ptr<Shard>> m_shards;
 
     P() : m_ctx(boost::asio::ssl::context::sslv23_client), m_logMessageCB(defaultLogFunction) {
     }
-};
 
-WSClient::WSClient() : m_p(std::make_unique<P>()) {
-    m_p->m_logMessageCB(LogSeverity::Info, "WSClient created");
-}
+    /// Uniformly distributed in [ceiling / 2, ceiling], ceiling = min(maxBackoff, initialBackoff * multiplier^attempt)
+    std::chrono::milliseconds backoff(const int attempt) const {
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        const auto ceiling = std::min(static_cast<double>(m_reconnectSettings.maxBackoff.count()),
+                                      static_cast<double>(m_reconnectSettings.initialBackoff.count()) *
+                                      std::pow(m_reconnectSettings.backoffMultiplier, attempt - 1));
+        std::uniform_int_distribution<std::int64_t> distribution(static_cast<std::int64_t>(ceiling / 2),
+                                                                 static_cast<std::int64_t>(ceiling));
+        return std::chrono::milliseconds(distribution(generator));
+    }
 
-WSClient::~WSClient() {
-    m_p->m_ioContext.stop();
+    [[nodiscard]] std::size_t maxSubscriptionsPerConnection() const {
+        return std::max<std::size_t>(m_shardingSettings.maxSubscriptionsPerConnection, 1);
+    }
+
+    /// Must be called with m_sessionLocker locked
+    Shard &addShard() {
+        const auto workerIndex = m_shards.size() % std::max<std::size_t>(m_shardingSettings.ioThreads, 1);
+
+        while (m_workers.size() <= workerIndex) {
+            m_workers.push_back(std::make_unique<IoWorker>());
+        }
 
-    if (m_p->m_ioThread.joinable()) {
-        m_p->m_ioThread.join();
+        return *m_shards.emplace_back(std::make_unique<Shard>(m_shards.size(), *m_workers[workerIndex]));
     }
 
-    m_p->m_logMessageCB(LogSeverity::Info, "WSClient destroyed");
-}
+    /// Must be called with m_sessionLocker locked
+    Shard *findShard(const nlohmann::json &subscriptionRequest) const {
+        for (const auto &shard: m_shards) {
+            if (shard->contains(subscriptionRequest)) {
+                return shard.get();
+            }
+        }
 
-void WSClient::run() const {
-    if (m_p->m_isRunning) {
-        return;
+        return nullptr;
+    }
+
+    /// Must be called with m_sessionLocker locked
+    Shard *leastLoadedShard() const {
+        Shard *retVal = nullptr;
+
+        for (const auto &shard: m_shards) {
+            if (!retVal || shard->subscriptions.size() < retVal->subscriptions.size()) {
+                retVal = shard.get();
+            }
+        }
+
+        return retVal;
+    }
+
+    /**
+     * Shard for a new subscription: the least loaded one, a new one is added while there are fewer than
+     * ShardingSettings::connections busy ones or all are full. Must be called with m_sessionLocker locked.
+     */
+    Shard &selectShard() {
+        auto *shard = leastLoadedShard();
+
+        if (!shard || shard->subscriptions.size() >= maxSubscriptionsPerConnection() ||
+            (!shard->subscriptions.empty() && m_shards.size() < m_shardingSettings.connections)) {
+            return addShard();
+        }
+
+        return *shard;
     }
 
-    m_p->m_isRunning = true;
+    /// Send the subscription over the connection of the shard, it must be assigned to the shard already
+    void sendSubscription(Shard &shard, const nlohmann::json &subscriptionRequest) {
+        if (shard.gapStart) {
+            /// Reconnecting, the subscription is sent with the replayed ones
+            return;
+        }
 
-    if (m_p->m_ioThread.joinable()) {
-        m_p->m_ioThread.join();
+        if (const auto session = shard.session.lock()) {
+            session->subscribe(subscriptionRequest);
+        } else {
+            openSession(shard);
+        }
     }
 
-    m_p->m_ioThread = std::thread([&] {
-        for (;;) {
-            try {
-                m_p->m_isRunning = true;
+    void deliverEvent(Event &&event) const {
+        if (m_dataEventCB) {
+            m_dataEventCB(event);
+        }
+
+        m_eventQueues.deliver(std::move(event));
+    }
+
+    /// Must be called with m_sessionLocker locked
+    void setChannel(const std::string_view channel, const onChannelFrame &handler) {
+        if (!m_shards.empty()) {
+            throw std::runtime_error("Channel handlers must be set before the first subscription");
+        }
+
+        m_channels.set(channel, handler);
+    }
 
-                if (m_p->m_ioContext.stopped()) {
-                    m_p->m_ioContext.restart();
+    /// Decode the ticker frames for m_tickers, must be called with m_sessionLocker locked
+    void routeTickers() {
+        setChannel("push.ticker", [this](const EventFrame &eventFrame) { m_tickers.deliver(decodeTicker(eventFrame)); });
+    }
+
+    /// Decode the candlestick frames for m_candlesticks, must be called with m_sessionLocker locked
+    void routeCandlesticks() {
+        setChannel("push.kline", [this](const EventFrame &eventFrame) {
+            m_candlesticks.deliver(decodeCandlestick(eventFrame));
+        });
+    }
+
+    /// Decode the depth updates and snapshots for m_depths, must be called with m_sessionLocker locked
+    void routeDepths() {
+        for (const auto isSnapshot: {false, true}) {
+            setChannel(isSnapshot ? "push.depth.full" : "push.depth", [this, isSnapshot](const EventFrame &eventFrame) {
+                m_depths.deliver(decodeDepth(eventFrame, isSnapshot));
+            });
+        }
+    }
+
+    /// Must be called with m_sessionLocker locked
+    void openSession(Shard &shard) {
+        if (shard.subscriptions.empty()) {
+            return;
+        }
+
+        const auto ws = std::make_shared<WebSocketSession>(shard.worker.ioContext, m_ctx, m_logMessageCB);
+        ws->setChannelRegistry(m_channels);
+        ws->setPermessageDeflate(m_permessageDeflate);
+        ws->setPingSettings(m_reconnectSettings.pingInterval, m_reconnectSettings.maxMissedPongs);
+        ws->setSessionClosedCallback([this, &shard, weak = std::weak_ptr(ws)] { onSessionClosed(shard, weak); });
+        ws->setSessionOpenedCallback([this, &shard] { onSessionOpened(shard); });
+        shard.session = ws;
+        ws->run(m_host, m_port, shard.subscriptions.front(),
+                [this](Event &&event) { deliverEvent(std::move(event)); });
+
+        for (std::size_t i = 1; i < shard.subscriptions.size(); ++i) {
+            ws->subscribe(shard.subscriptions[i]);
+        }
+    }
+
+    void onSessionClosed(Shard &shard, const std::weak_ptr<WebSocketSession> &weak) {
+        if (m_isClosing) {
+            return;
+        }
+
+        /// Set when the gap opens, reported after the lock is released
+        std::optional<StreamGap> lostStream;
+
+        {
+            std::lock_guard lk(m_sessionLocker);
+            const auto session = weak.lock();
+
+            if (!session || session != shard.session.lock() || shard.subscriptions.empty()) {
+                return;
+            }
+
+            if (!shard.gapStart) {
+                const auto lastReceiveTime = session->lastReceiveTime();
+                shard.gapStart = lastReceiveTime == std::chrono::system_clock::time_point{}
+                                     ? std::chrono::system_clock::now()
+                                     : lastReceiveTime;
+                lostStream.emplace();
+                lostStream->from = *shard.gapStart;
+                lostStream->connection = shard.index;
+                lostStream->subscriptions = shard.subscriptions;
+            }
+
+            const auto delay = backoff(++shard.attempts);
+            m_logMessageCB(LogSeverity::Warning,
+                           fmt::format("WebSocket connection {} lost, reconnecting in {} ms, attempt {}", shard.index,
+                                       delay.count(), shard.attempts));
+
+            shard.reconnectTimer.expires_after(delay);
+            shard.reconnectTimer.async_wait([this, &shard](const boost::system::error_code &ec) {
+                if (ec || m_isClosing) {
+                    return;
                 }
-                m_p->m_ioContext.run();
-                m_p->m_isRunning = false;
-                break;
-            } catch (std::exception &e) {
-                if (m_p->m_logMessageCB) {
-                    m_p->m_logMessageCB(LogSeverity::Error, fmt::format("{}: {}\n", MAKE_FILELINE, e.what()));
+
+                std::lock_guard lock(m_sessionLocker);
+                openSession(shard);
+            });
+        }
+
+        if (lostStream && m_connectionLostCB) {
+            m_connectionLostCB(*lostStream);
+        }
+    }
+
+    void onSessionOpened(Shard &shard) {
+        StreamGap streamGap;
+
+        {
+            std::lock_guard lk(m_sessionLocker);
+
+            if (!shard.gapStart) {
+                return;
+            }
+
+            streamGap.from = *shard.gapStart;
+            streamGap.to = std::chrono::system_clock::now();
+            streamGap.attempts = shard.attempts;
+            streamGap.connection = shard.index;
+            streamGap.subscriptions = shard.subscriptions;
+            shard.gapStart.reset();
+            shard.attempts = 0;
+        }
+
+        m_logMessageCB(LogSeverity::Info, fmt::format("WebSocket connection {} recovered after {} attempts",
+                                                      streamGap.connection, streamGap.attempts));
+
+        if (m_streamGapCB) {
+            m_streamGapCB(streamGap);
+        }
+    }
+
+    void runWorker(IoWorker &worker) const {
+        if (worker.isRunning) {
+            return;
+        }
+
+        worker.isRunning = true;
+
+        if (worker.ioThread.joinable()) {
+            worker.ioThread.join();
+        }
+
+        worker.ioThread = std::thread([this, &worker] {
+            for (;;) {
+                try {
+                    worker.isRunning = true;
+
+                    if (worker.ioContext.stopped()) {
+                        worker.ioContext.restart();
+                    }
+                    worker.ioContext.run();
+                    worker.isRunning = false;
+                    break;
+                } catch (std::exception &e) {
+                    if (m_logMessageCB) {
+                        m_logMessageCB(LogSeverity::Error, fmt::format("{}: {}\n", MAKE_FILELINE, e.what()));
+                    }
                 }
             }
+
+            worker.isRunning = false;
+        });
+    }
+};
+
+WSClient::WSClient() : m_p(std::make_unique<P>()) {
+    m_p->m_logMessageCB(LogSeverity::Info, "WSClient created");
+}
+
+WSClient::~WSClient() {
+    /// Not locked, the IO threads may be waiting for the lock in a session callback
+    m_p->m_isClosing = true;
+
+    /// Releases the IO threads blocked by a full queue with OverflowPolicy::Block
+    m_p->m_eventQueues.close();
+    m_p->m_tickers.queues.close();
+    m_p->m_candlesticks.queues.close();
+    m_p->m_depths.queues.close();
+
+    for (const auto &worker: m_p->m_workers) {
+        worker->ioContext.stop();
+    }
+
+    for (const auto &worker: m_p->m_workers) {
+        if (worker->ioThread.joinable()) {
+            worker->ioThread.join();
         }
+    }
 
-        m_p->m_isRunning = false;
-    });
+    m_p->m_logMessageCB(LogSeverity::Info, "WSClient destroyed");
 }
 
+void WSClient::run() const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+
+    for (const auto &worker: m_p->m_workers) {
+        m_p->runWorker(*worker);
+    }
+}
 
 void WSClient::setLoggerCallback(const onLogMessage &onLogMessageCB) const {
     m_p->m_logMessageCB = onLogMessageCB;
@@ -87,22 +462,173 @@ void WSClient::setDataEventCallback(const onDataEvent &onDataEventCB) const {
     m_p->m_dataEventCB = onDataEventCB;
 }
 
+std::shared_ptr<EventQueue<Event>> WSClient::addEventQueue(const EventQueueSettings &settings) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    return m_p->m_eventQueues.add(settings);
+}
+
+std::shared_ptr<EventQueue<EventTicker>> WSClient::addEventTickerQueue(const EventQueueSettings &settings) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeTickers();
+    return m_p->m_tickers.queues.add(settings);
+}
+
+std::shared_ptr<EventQueue<EventCandlestick>>
+WSClient::addEventCandlestickQueue(const EventQueueSettings &settings) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeCandlesticks();
+    return m_p->m_candlesticks.queues.add(settings);
+}
+
+std::shared_ptr<EventQueue<EventDepth>> WSClient::addEventDepthQueue(const EventQueueSettings &settings) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeDepths();
+    return m_p->m_depths.queues.add(settings);
+}
+
+void WSClient::setEventTickerCallback(const onEventTicker &onEventTickerCB) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeTickers();
+    m_p->m_tickers.callback = onEventTickerCB;
+}
+
+void WSClient::setEventCandlestickCallback(const onEventCandlestick &onEventCandlestickCB) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeCandlesticks();
+    m_p->m_candlesticks.callback = onEventCandlestickCB;
+}
+
+void WSClient::setEventDepthCallback(const onEventDepth &onEventDepthCB) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->routeDepths();
+    m_p->m_depths.callback = onEventDepthCB;
+}
+
+void WSClient::setChannelHandler(const std::string_view channel, const onChannelFrame &handler) const {
+    /// The sessions take a copy of the registry when they open, from the IO threads under the same lock
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->setChannel(channel, handler);
+}
+
+void WSClient::setStreamGapCallback(const onStreamGap &onStreamGapCB) const {
+    m_p->m_streamGapCB = onStreamGapCB;
+}
+
+void WSClient::setConnectionLostCallback(const onConnectionLost &onConnectionLostCB) const {
+    m_p->m_connectionLostCB = onConnectionLostCB;
+}
+
+void WSClient::setReconnectSettings(const ReconnectSettings &settings) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->m_reconnectSettings = settings;
+}
+
+void WSClient::setEndpoint(const std::string &host, const std::string &port) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->m_host = host;
+    m_p->m_port = port;
+}
+
+void WSClient::setPermessageDeflate(const bool enable) const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    m_p->m_permessageDeflate = enable;
+}
+
+void WSClient::setShardingSettings(const ShardingSettings &settings) const {
+    {
+        std::lock_guard lk(m_p->m_sessionLocker);
+        m_p->m_shardingSettings = settings;
+    }
+
+    rebalance();
+}
+
+ShardingSettings WSClient::shardingSettings() const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    return m_p->m_shardingSettings;
+}
+
 void WSClient::subscribe(const nlohmann::json &subscriptionRequest) const {
-    if (const auto session = m_p->m_session.lock()) {
-        session->subscribe(subscriptionRequest);
-        return;
+    {
+        std::lock_guard lk(m_p->m_sessionLocker);
+
+        if (auto *shard = m_p->findShard(subscriptionRequest)) {
+            m_p->sendSubscription(*shard, subscriptionRequest);
+        } else {
+            auto &selected = m_p->selectShard();
+            selected.subscriptions.push_back(subscriptionRequest);
+            m_p->sendSubscription(selected, subscriptionRequest);
+        }
+    }
+
+    run();
+}
+
+void WSClient::rebalance() const {
+    {
+        std::lock_guard lk(m_p->m_sessionLocker);
+        std::size_t total = 0;
+
+        for (const auto &shard: m_p->m_shards) {
+            total += shard->subscriptions.size();
+        }
+
+        if (total == 0) {
+            return;
+        }
+
+        const auto cap = m_p->maxSubscriptionsPerConnection();
+        const auto required = std::max(m_p->m_shardingSettings.connections, (total + cap - 1) / cap);
+
+        while (m_p->m_shards.size() < required) {
+            m_p->addShard();
+        }
+
+        const auto target = std::min(cap, (total + m_p->m_shards.size() - 1) / m_p->m_shards.size());
+
+        for (const auto &source: m_p->m_shards) {
+            while (source->subscriptions.size() > target) {
+                auto *destination = m_p->leastLoadedShard();
+
+                if (destination->subscriptions.size() >= target) {
+                    break;
+                }
+
+                auto subscriptionRequest = std::move(source->subscriptions.back());
+                source->subscriptions.pop_back();
+
+                if (const auto session = source->session.lock()) {
+                    session->unsubscribe(subscriptionRequest);
+                }
+
+                destination->subscriptions.push_back(subscriptionRequest);
+                m_p->sendSubscription(*destination, subscriptionRequest);
+            }
+        }
     }
 
-    const auto ws = std::make_shared<WebSocketSession>(m_p->m_ioContext, m_p->m_ctx, m_p->m_logMessageCB);
-    std::weak_ptr wp{ws};
-    m_p->m_session = std::move(wp);
-    ws->run(MEXC_FUTURES_WS_HOST, MEXC_FUTURES_WS_PORT, subscriptionRequest, m_p->m_dataEventCB);
     run();
 }
 
+std::vector<std::size_t> WSClient::connectionLoads() const {
+    std::lock_guard lk(m_p->m_sessionLocker);
+    std::vector<std::size_t> retVal;
+    retVal.reserve(m_p->m_shards.size());
+
+    for (const auto &shard: m_p->m_shards) {
+        retVal.push_back(shard->subscriptions.size());
+    }
+
+    return retVal;
+}
+
 bool WSClient::isSubscribed(const nlohmann::json &subscriptionRequest) const {
-    if (const auto session = m_p->m_session.lock()) {
-        return session->isSubscribed(subscriptionRequest);
+    std::lock_guard lk(m_p->m_sessionLocker);
+
+    if (const auto *shard = m_p->findShard(subscriptionRequest)) {
+        if (const auto session = shard->session.lock()) {
+            return session->isSubscribed(subscriptionRequest);
+        }
     }
 
     return false;
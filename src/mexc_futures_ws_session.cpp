@@ -7,105 +7,240 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 */
 
 #include "vk/mexc/mexc_futures_ws_session.h"
+#include "vk/mexc/mexc_frame_inflater.h"
 #include "vk/utils/log_utils.h"
 #include "vk/utils/json_utils.h"
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
-#include <boost/asio/buffers_iterator.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <list>
 
 namespace vk::mexc::futures {
-static constexpr int PING_INTERVAL_IN_S = 20;
+static constexpr auto DEFAULT_PING_INTERVAL = std::chrono::seconds(20);
+static constexpr int DEFAULT_MAX_MISSED_PONGS = 2;
+
+/// Responses to the (un)subscriptions of the public channels
+static constexpr std::array CONTROL_CHANNELS = {
+    "rs.sub.ticker", "rs.sub.tickers", "rs.sub.kline", "rs.sub.deal", "rs.sub.depth", "rs.sub.depth.full",
+    "rs.sub.funding.rate", "rs.sub.index.price", "rs.sub.fair.price", "rs.unsub.ticker", "rs.unsub.tickers",
+    "rs.unsub.kline", "rs.unsub.deal", "rs.unsub.depth", "rs.unsub.depth.full", "rs.unsub.funding.rate",
+    "rs.unsub.index.price", "rs.unsub.fair.price", "rs.error"
+};
 
 struct WebSocketSession::P {
     boost::asio::ip::tcp::resolver resolver;
     boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>> ws;
-    boost::beast::multi_buffer buffer;
+    boost::beast::flat_buffer buffer;
+    /// Pushes of the subscriptions with the compress flag come as compressed binary frames
+    FrameInflater inflater;
+    bool permessageDeflate{false};
     std::string host;
     std::vector<nlohmann::json> subscriptions;
+    /// Requests which are not sent yet
     std::list<nlohmann::json> subscriptionRequests;
-    nlohmann::json subscribing;
+    /// Sent requests waiting for their acknowledgement in the order of sending, acknowledgements carry no symbol and
+    /// come in the same order
+    std::deque<nlohmann::json> inFlight;
+    /// Messages being written back-to-back, the front one is in progress, accessed on the strand only
+    std::deque<std::string> writeQueue;
+    bool isConnected{false};
+    std::weak_ptr<WebSocketSession> weakSelf;
     onLogMessage logMessageCB;
-    onDataEvent dataEventCB;
+    onSessionDataEvent dataEventCB;
+    ChannelRegistry channels;
+    onSessionClosed sessionClosedCB;
+    onSessionOpened sessionOpenedCB;
+    std::chrono::time_point<std::chrono::system_clock> lastReceiveTime{};
     boost::asio::steady_timer pingTimer;
+    std::chrono::milliseconds pingInterval{DEFAULT_PING_INTERVAL};
+    int maxMissedPongs{DEFAULT_MAX_MISSED_PONGS};
+    /// Consecutive pings without a pong
+    int missedPongs{};
     std::chrono::time_point<std::chrono::system_clock> lastPingTime{};
     std::chrono::time_point<std::chrono::system_clock> lastPongTime{};
     mutable std::recursive_mutex subscriptionLocker;
 
     P(boost::asio::io_context &ioc, boost::asio::ssl::context &ctx, const onLogMessage &onLogMessageCB)
         : resolver(make_strand(ioc)), ws(make_strand(ioc), ctx), logMessageCB(onLogMessageCB),
-          pingTimer(ioc, boost::asio::chrono::seconds(PING_INTERVAL_IN_S)) {}
+          pingTimer(ioc) {
+        registerControlChannels();
+    }
+
+    void notifyClosed() {
+        pingTimer.cancel();
+
+        if (sessionClosedCB) {
+            const auto closedCB = std::move(sessionClosedCB);
+            sessionClosedCB = nullptr;
+            closedCB();
+        }
+    }
+
+    void registerControlChannels() {
+        for (const auto *channel: CONTROL_CHANNELS) {
+            channels.set(channel, [this](const EventFrame &eventFrame) {
+                handleApiControlMsg(nlohmann::json::parse(eventFrame.text));
+            });
+        }
+    }
+
+    [[nodiscard]] bool isInFlight(const nlohmann::json &subscriptionRequest) const {
+        return std::ranges::find(inFlight, subscriptionRequest) != inFlight.end();
+    }
+
+    [[nodiscard]] bool hasSubscriptions() const {
+        return !subscriptions.empty() || !subscriptionRequests.empty() || !inFlight.empty();
+    }
 
     void writeSubscription(const nlohmann::json &subscriptionRequest) {
         std::lock_guard lk(subscriptionLocker);
 
-        /// Check if already subscribed
-        for (const auto &sub: subscriptions) {
-            if (sub["method"] == subscriptionRequest["method"]) {
-                if (sub["symbol"] == subscriptionRequest["symbol"]) {
-                    return;
-                }
-            }
+        /// Check if already subscribed or pending
+        if (std::ranges::find(subscriptions, subscriptionRequest) != subscriptions.end() ||
+            std::ranges::find(subscriptionRequests, subscriptionRequest) != subscriptionRequests.end() ||
+            isInFlight(subscriptionRequest)) {
+            return;
         }
 
         subscriptionRequests.emplace_back(subscriptionRequest);
     }
 
-    std::string readSubscription() {
+    void writeUnsubscription(const nlohmann::json &subscriptionRequest) {
         std::lock_guard lk(subscriptionLocker);
-        std::string retVal;
 
-        if (subscriptionRequests.empty()) {
-            return "";
+        /// Not sent yet, it is enough to drop it
+        if (const auto it = std::ranges::find(subscriptionRequests, subscriptionRequest);
+            it != subscriptionRequests.end()) {
+            subscriptionRequests.erase(it);
+            return;
         }
 
-        try {
-            subscribing = subscriptionRequests.front();
-            retVal = subscriptionRequests.front().dump();
-        } catch (std::exception &e) {
-            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+        if (const auto it = std::ranges::find(subscriptions, subscriptionRequest); it != subscriptions.end()) {
+            subscriptions.erase(it);
+        } else if (!isInFlight(subscriptionRequest)) {
+            return;
         }
 
-        subscriptionRequests.pop_front();
-        return retVal;
+        /// e.g. sub.ticker -> unsub.ticker with the same parameters
+        auto unsubscription = subscriptionRequest;
+        unsubscription["method"] = "un" + subscriptionRequest["method"].get<std::string>();
+        subscriptionRequests.emplace_back(std::move(unsubscription));
     }
 
-    static bool isApiControlMsg(const nlohmann::json &json) {
-        if (json.contains("channel")) {
-            {
-                if (const auto channel = json["channel"].get<std::string>(); channel.find("rs.") != std::string::npos) {
-                    return true;
-                }
+    /// Send all pending requests back-to-back without waiting for their acknowledgements, runs on the strand
+    void flushSubscriptions(const std::shared_ptr<WebSocketSession> &self) {
+        if (!isConnected) {
+            return;
+        }
+
+        const bool isIdle = writeQueue.empty();
+
+        {
+            std::lock_guard lk(subscriptionLocker);
+
+            while (!subscriptionRequests.empty()) {
+                auto &request = subscriptionRequests.front();
+                writeQueue.push_back(request.dump());
+                inFlight.push_back(std::move(request));
+                subscriptionRequests.pop_front();
             }
         }
 
+        if (isIdle && !writeQueue.empty()) {
+            writeNext(self);
+        }
+    }
+
+    void writeNext(const std::shared_ptr<WebSocketSession> &self) {
+        ws.async_write(boost::asio::buffer(writeQueue.front()),
+                       [this, self](const boost::beast::error_code &e, const std::size_t bytesTransferred) {
+                           onWrite(self, e, bytesTransferred);
+                       });
+    }
+
+    /// Control messages of channels which are not in CONTROL_CHANNELS
+    static bool isApiControlMsg(const nlohmann::json &json) {
+        if (const auto it = json.find("channel"); it != json.end() && it->is_string()) {
+            return it->get_ref<const std::string &>().starts_with("rs.");
+        }
+
         return false;
     }
 
+    /**
+     * Pass the frame to the handler of its channel
+     * @param frame
+     * @return false if the channel is not registered, the frame has to be parsed into a DOM then
+     */
+    bool dispatchFrame(const std::string_view frame) {
+        EventFrame eventFrame;
+
+        if (!eventFrame.scan(frame)) {
+            return false;
+        }
+
+        try {
+            return channels.dispatch(eventFrame);
+        } catch (std::exception &e) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+            return true;
+        }
+    }
+
     void handleApiControlMsg(const nlohmann::json &json) {
         std::lock_guard lk(subscriptionLocker);
 
-        if (json.contains("data")) {
-            bool isError = false;
-            isError = json["data"].get<std::string>() != "success";
+        /// e.g. rs.sub.ticker acknowledges the oldest sub.ticker request in flight
+        nlohmann::json request;
+
+        if (const auto channel = json.value("channel", std::string()); channel == "rs.error") {
+            /// The error does not name the request, it answers the oldest one which is not acknowledged yet
+            if (!inFlight.empty()) {
+                request = std::move(inFlight.front());
+                inFlight.pop_front();
+            } else {
+                logMessageCB(LogSeverity::Warning, fmt::format("MEXC API error without a request in flight: {}",
+                                                               json.dump()));
+            }
+        } else if (channel.starts_with("rs.")) {
+            const auto method = std::string_view(channel).substr(3);
+
+            if (const auto it = std::ranges::find_if(inFlight, [&](const nlohmann::json &inFlightRequest) {
+                return inFlightRequest.value("method", std::string()) == method;
+            }); it != inFlight.end()) {
+                if (it != inFlight.begin()) {
+                    /// Older requests were not answered, the following errors may be attributed to wrong requests
+                    logMessageCB(LogSeverity::Warning, fmt::format("MEXC API acknowledgement {} skips {} requests",
+                                                                   channel, std::distance(inFlight.begin(), it)));
+                }
 
-            if (isError) {
-                if (const auto it = std::ranges::find(subscriptions, subscribing); it != subscriptions.end()) {
+                request = std::move(*it);
+                inFlight.erase(it);
+            }
+        }
+
+        if (json.contains("data")) {
+            if (const auto &data = json["data"]; !data.is_string() || data.get_ref<const std::string &>() != "success") {
+                if (const auto it = std::ranges::find(subscriptions, request); it != subscriptions.end()) {
                     subscriptions.erase(it);
                 }
 
-                logMessageCB(LogSeverity::Error,
-                             fmt::format("MEXC API Error, subscription failed {}", subscribing.dump()));
-                subscribing = nlohmann::json();
+                logMessageCB(LogSeverity::Error, fmt::format("MEXC API Error, subscription failed {}, {}",
+                                                             request.dump(), json.dump()));
                 return;
             }
-            subscriptions.push_back(subscribing);
-            subscribing = nlohmann::json();
+
+            /// Confirmation of an unsubscription is not a subscription
+            if (request.is_object() && !request.value("method", std::string()).starts_with("unsub.")) {
+                subscriptions.push_back(std::move(request));
+            }
         }
 
         logMessageCB(LogSeverity::Info, fmt::format("MEXC API control msg: {}", json.dump()));
@@ -124,7 +259,8 @@ struct WebSocketSession::P {
     void onResolve(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
                    const boost::asio::ip::tcp::resolver::results_type &results) {
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
         get_lowest_layer(ws).expires_after(std::chrono::seconds(30));
@@ -139,14 +275,16 @@ struct WebSocketSession::P {
     void onConnect(const std::shared_ptr<WebSocketSession> &self, boost::beast::error_code ec,
                    const boost::asio::ip::tcp::resolver::results_type::endpoint_type &ep) {
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
         get_lowest_layer(ws).expires_after(std::chrono::seconds(30));
 
         if (!SSL_set_tlsext_host_name(ws.next_layer().native_handle(), host.c_str())) {
             ec = boost::beast::error_code(static_cast<int>(ERR_get_error()), boost::asio::error::get_ssl_category());
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
         host += ':' + std::to_string(ep.port());
@@ -157,7 +295,8 @@ struct WebSocketSession::P {
 
     void onSSLHandshake(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
         ws.control_callback([this](boost::beast::websocket::frame_type kind, boost::beast::string_view payload) {
@@ -170,6 +309,12 @@ struct WebSocketSession::P {
 
         get_lowest_layer(ws).expires_never();
 
+        if (permessageDeflate) {
+            boost::beast::websocket::permessage_deflate option;
+            option.client_enable = true;
+            ws.set_option(option);
+        }
+
         ws.set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::client));
 
         ws.set_option(boost::beast::websocket::stream_base::decorator([](boost::beast::websocket::request_type &req) {
@@ -183,15 +328,19 @@ struct WebSocketSession::P {
 
     void onHandshake(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
+        pingTimer.expires_after(pingInterval);
         pingTimer.async_wait([this, self](const boost::beast::error_code &e) { onPingTimer(self, e); });
 
-        ws.async_write(boost::asio::buffer(readSubscription()),
-                       [this, self](const boost::beast::error_code &e, const std::size_t bytesTransferred) {
-                           onWrite(self, e, bytesTransferred);
-                       });
+        isConnected = true;
+        flushSubscriptions(self);
+
+        ws.async_read(buffer, [this, self](const boost::beast::error_code &e, const std::size_t transferred) {
+            onRead(self, e, transferred);
+        });
     }
 
     void onWrite(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
@@ -199,12 +348,15 @@ struct WebSocketSession::P {
         boost::ignore_unused(bytesTransferred);
 
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
-        ws.async_read(buffer, [this, self](const boost::beast::error_code &e, const std::size_t transferred) {
-            onRead(self, e, transferred);
-        });
+        writeQueue.pop_front();
+
+        if (!writeQueue.empty()) {
+            writeNext(self);
+        }
     }
 
     void onRead(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
@@ -212,46 +364,57 @@ struct WebSocketSession::P {
         boost::ignore_unused(bytesTransferred);
 
         if (ec) {
-            pingTimer.cancel();
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
         }
 
-        try {
-            const auto size = buffer.size();
-            std::string strBuffer;
-            strBuffer.reserve(size);
-
-            for (const auto &it: buffer.data()) {
-                strBuffer.append(static_cast<const char *>(it.data()), it.size());
-            }
+        lastReceiveTime = std::chrono::system_clock::now();
 
-            buffer.consume(buffer.size());
+        if (sessionOpenedCB) {
+            const auto openedCB = std::move(sessionOpenedCB);
+            sessionOpenedCB = nullptr;
+            openedCB();
+        }
 
-            if (const nlohmann::json json = nlohmann::json::parse(strBuffer); json.is_object()) {
-                if (isApiControlMsg(json)) {
-                    handleApiControlMsg(json);
-                } else {
-                    try {
-                        Event dataEvent;
-                        dataEvent.fromJson(json);
+        try {
+            /// The frame is contiguous in the flat buffer, parse it in place, the buffer keeps its capacity
+            const auto data = buffer.cdata();
+            std::string_view frame(static_cast<const char *>(data.data()), data.size());
+
+            if (ws.got_binary()) {
+                try {
+                    frame = inflater.inflate(frame);
+                } catch (std::exception &e) {
+                    logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+                    frame = {};
+                }
+            }
 
-                        if (dataEventCB) {
-                            dataEventCB(dataEvent);
+            if (!frame.empty() && !dispatchFrame(frame)) {
+                if (const nlohmann::json json = nlohmann::json::parse(frame); json.is_object()) {
+                    if (isApiControlMsg(json)) {
+                        handleApiControlMsg(json);
+                    } else {
+                        try {
+                            Event dataEvent;
+                            dataEvent.fromJson(json);
+
+                            if (dataEventCB) {
+                                dataEventCB(std::move(dataEvent));
+                            }
+                        } catch (std::exception &e) {
+                            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
                         }
-                    } catch (std::exception &e) {
-                        logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
                     }
                 }
             }
 
-            if (const auto subscription = readSubscription(); !subscription.empty()) {
-                ws.async_write(boost::asio::buffer(subscription),
-                               [this, self](const boost::beast::error_code &e, const std::size_t transferred) {
-                                   onWrite(self, e, transferred);
-                               });
-            } else {
+            buffer.consume(buffer.size());
+            flushSubscriptions(self);
+
+            {
                 std::lock_guard lk(subscriptionLocker);
-                if (subscriptions.empty()) {
+                if (!hasSubscriptions()) {
                     logMessageCB(LogSeverity::Warning,
                                  fmt::format("No subscriptions, WebSocketSession quit: {}", MAKE_FILELINE));
                     closeWs();
@@ -267,22 +430,36 @@ struct WebSocketSession::P {
         }
     }
 
-    void ping() {
-        if (const std::chrono::duration<double> elapsed = lastPingTime - lastPongTime;
-            elapsed.count() > PING_INTERVAL_IN_S) {
-            logMessageCB(LogSeverity::Warning, fmt::format("{}: {}", MAKE_FILELINE, "ping expired"));
+    /**
+     * Send a ping, the connection is closed instead when the pongs of the last maxMissedPongs pings did not come
+     * @return false if the connection was closed
+     */
+    bool ping() {
+        missedPongs = lastPongTime < lastPingTime ? missedPongs + 1 : 0;
+
+        if (missedPongs >= maxMissedPongs) {
+            logMessageCB(LogSeverity::Warning,
+                         fmt::format("{}: no pong for {} pings, closing the connection", MAKE_FILELINE, missedPongs));
+
+            /// The peer does not answer, a close handshake would wait for it. The pending read fails and ends the
+            /// session, which lets the client reconnect.
+            boost::beast::error_code closeEc;
+            get_lowest_layer(ws).socket().close(closeEc);
+            return false;
         }
 
         if (ws.is_open()) {
+            /// Taken before sending, so the pong can never be older than its ping
+            lastPingTime = std::chrono::system_clock::now();
             const boost::beast::websocket::ping_data pingWebSocketFrame;
             ws.async_ping(pingWebSocketFrame, [this](const boost::beast::error_code &ec) {
                 if (ec) {
                     logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
-                } else {
-                    lastPingTime = std::chrono::system_clock::now();
                 }
             });
         }
+
+        return true;
     }
 
     void closeWs() {
@@ -294,8 +471,10 @@ struct WebSocketSession::P {
         pingTimer.cancel();
 
         if (ec) {
-            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
         }
+
+        notifyClosed();
     }
 
     void onPingTimer(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
@@ -303,8 +482,11 @@ struct WebSocketSession::P {
             return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
         }
 
-        ping();
-        pingTimer.expires_after(boost::asio::chrono::seconds(PING_INTERVAL_IN_S));
+        if (!ping()) {
+            return;
+        }
+
+        pingTimer.expires_after(pingInterval);
         pingTimer.async_wait([this, self](const boost::beast::error_code &e) { onPingTimer(self, e); });
     }
 };
@@ -322,6 +504,18 @@ WebSocketSession::~WebSocketSession() {
 
 void WebSocketSession::subscribe(const nlohmann::json &subscriptionRequest) const {
     m_p->writeSubscription(subscriptionRequest);
+    flush();
+}
+
+void WebSocketSession::unsubscribe(const nlohmann::json &subscriptionRequest) const {
+    m_p->writeUnsubscription(subscriptionRequest);
+    flush();
+}
+
+void WebSocketSession::flush() const {
+    if (const auto self = m_p->weakSelf.lock()) {
+        boost::asio::post(m_p->ws.get_executor(), [this, self] { m_p->flushSubscriptions(self); });
+    }
 }
 
 bool WebSocketSession::isSubscribed(const nlohmann::json &subscriptionRequest) const {
@@ -329,12 +523,13 @@ bool WebSocketSession::isSubscribed(const nlohmann::json &subscriptionRequest) c
 }
 
 void WebSocketSession::run(const std::string &host, const std::string &port, const nlohmann::json &subscriptionRequest,
-                           const onDataEvent &dataEventCB) {
+                           const onSessionDataEvent &dataEventCB) {
     m_p->host = host;
     m_p->writeSubscription(subscriptionRequest);
     m_p->dataEventCB = dataEventCB;
 
     auto self = shared_from_this();
+    m_p->weakSelf = self;
     m_p->resolver.async_resolve(
         host, port,
         [this, self](const boost::beast::error_code &ec, const boost::asio::ip::tcp::resolver::results_type &results) {
@@ -342,5 +537,35 @@ void WebSocketSession::run(const std::string &host, const std::string &port, con
         });
 }
 
+void WebSocketSession::setChannelRegistry(const ChannelRegistry &channelRegistry) const {
+    m_p->channels = channelRegistry;
+    m_p->registerControlChannels();
+}
+
+void WebSocketSession::setPermessageDeflate(const bool enable) const {
+    m_p->permessageDeflate = enable;
+}
+
+void WebSocketSession::setPingSettings(const std::chrono::milliseconds interval, const int maxMissedPongs) const {
+    m_p->pingInterval = interval;
+    m_p->maxMissedPongs = std::max(maxMissedPongs, 1);
+}
+
+InflaterStats WebSocketSession::inflaterStats() const {
+    return m_p->inflater.stats();
+}
+
+void WebSocketSession::setSessionClosedCallback(const onSessionClosed &sessionClosedCB) const {
+    m_p->sessionClosedCB = sessionClosedCB;
+}
+
+void WebSocketSession::setSessionOpenedCallback(const onSessionOpened &sessionOpenedCB) const {
+    m_p->sessionOpenedCB = sessionOpenedCB;
+}
+
+std::chrono::system_clock::time_point WebSocketSession::lastReceiveTime() const {
+    return m_p->lastReceiveTime;
+}
+
 void WebSocketSession::close() const { m_p->closeWs(); }
 } // namespace vk::mexc::futures
@@ -45,12 +45,19 @@ struct HTTPSession::P {
 	AuthSource authSource = AuthSource::OpenAPI;
 	std::string uri;
 	const EVP_MD *evpMd;
+	std::shared_ptr<ClockSync> clockSync;
 
 	P() : evpMd(EVP_sha256()) {
 		uri = API_URI_FUTURES;
 	}
 
-	http::response<http::string_body> request(http::request<http::string_body> req);
+	http::response<http::string_body> request(http::request<http::string_body> req,
+	                                          std::int64_t *requestTime = nullptr,
+	                                          std::int64_t *responseTime = nullptr);
+
+	[[nodiscard]] std::int64_t timestamp() const {
+		return clockSync ? clockSync->now() : getMsTimestamp(currentTime()).count();
+	}
 
 	static std::string createQueryStr(const std::map<std::string, std::string> &parameters) {
 		std::string queryStr;
@@ -72,7 +79,7 @@ struct HTTPSession::P {
 	void authenticateGet(http::request<http::string_body> &req, const std::map<std::string, std::string> &parameters) const {
 
 		const std::string parameterString = createQueryStr(parameters);
-		const auto ts = getMsTimestamp(currentTime()).count();
+		const auto ts = timestamp();
 		const std::string strToSign = apiKey + std::to_string(ts) + parameterString;
 
 		unsigned char digest[SHA256_DIGEST_LENGTH];
@@ -85,6 +92,7 @@ struct HTTPSession::P {
 		req.set("ApiKey", apiKey);
 		req.set("Content-Type", "application/json");
 		req.set("Request-Time", std::to_string(ts));
+		req.set("Recv-Window", std::to_string(receiveWindow));
 		req.set("Signature", stringToHex(digest, sizeof(digest)));
 	}
 
@@ -95,8 +103,7 @@ struct HTTPSession::P {
 
 	/// WEB authentication for POST requests (Authorization + MD5 signing)
 	void authenticateWebPost(http::request<http::string_body> &req, const std::string &jsonBody) const {
-		const auto ts = getMsTimestamp(currentTime()).count();
-		const std::string timestamp = std::to_string(ts);
+		const std::string timestamp = std::to_string(this->timestamp());
 
 		// Step 1: g = MD5(token + timestamp), drop first 7 hex chars
 		const std::string g = md5Hex(webToken + timestamp).substr(7);
@@ -139,6 +146,20 @@ HTTPSession::HTTPSession(const std::string &webToken, const AuthSource source) :
 
 HTTPSession::~HTTPSession() = default;
 
+void HTTPSession::setClockSync(const std::shared_ptr<ClockSync> &clockSync) const {
+	m_p->clockSync = clockSync;
+}
+
+void HTTPSession::setReceiveWindow(const int receiveWindow) const {
+	m_p->receiveWindow = receiveWindow;
+}
+
+http::response<http::string_body> HTTPSession::methodGetTimed(const std::string &path, std::int64_t &requestTime,
+                                                              std::int64_t &responseTime) const {
+	const http::request<http::string_body> req{http::verb::get, path, 11};
+	return m_p->request(req, &requestTime, &responseTime);
+}
+
 http::response<http::string_body> HTTPSession::methodGet(const std::string &path,
                                                          const std::map<std::string, std::string> &parameters,
                                                          const bool isPublic) const {
@@ -179,7 +200,7 @@ http::response<http::string_body> HTTPSession::methodPost(const std::string &pat
 }
 
 http::response<http::string_body> HTTPSession::P::request(
-	http::request<http::string_body> req) {
+	http::request<http::string_body> req, std::int64_t *requestTime, std::int64_t *responseTime) {
 	req.set(http::field::host, uri);
 
 	if (authSource == AuthSource::Web) {
@@ -207,11 +228,19 @@ http::response<http::string_body> HTTPSession::P::request(
 	net::connect(stream.next_layer(), results.begin(), results.end());
 	stream.handshake(ssl::stream_base::client);
 
+	if (requestTime) {
+		*requestTime = getMsTimestamp(currentTime()).count();
+	}
+
 	http::write(stream, req);
 	beast::flat_buffer buffer;
 	http::response<http::string_body> response;
 	http::read(stream, buffer, response);
 
+	if (responseTime) {
+		*responseTime = getMsTimestamp(currentTime()).count();
+	}
+
 	boost::system::error_code ec;
 	stream.shutdown(ec);
 	if (ec == boost::asio::error::eof) {
@@ -29,11 +29,18 @@ struct HTTPSession::P {
     std::string apiSecret;
     std::string uri;
     const EVP_MD *evpMd;
+    std::shared_ptr<ClockSync> clockSync;
 
     P() : evpMd(EVP_sha256()) {
     }
 
-    http::response<http::string_body> request(http::request<http::string_body> req);
+    http::response<http::string_body> request(http::request<http::string_body> req,
+                                              std::int64_t *requestTime = nullptr,
+                                              std::int64_t *responseTime = nullptr);
+
+    [[nodiscard]] std::int64_t timestamp() const {
+        return clockSync ? clockSync->now() : getMsTimestamp(currentTime()).count();
+    }
 
     static std::string createQueryStr(const std::map<std::string, std::string> &parameters) {
         std::string queryStr;
@@ -52,8 +59,8 @@ struct HTTPSession::P {
     }
 
     void sign(std::map<std::string, std::string> &parameters) const {
-        const auto ts = getMsTimestamp(currentTime()).count();
-        parameters["timestamp"] = std::to_string(ts);
+        parameters["timestamp"] = std::to_string(timestamp());
+        parameters["recvWindow"] = std::to_string(receiveWindow);
 
         const std::string parameterString = createQueryStr(parameters);
 
@@ -99,6 +106,21 @@ HTTPSession::HTTPSession(const std::string &apiKey, const std::string &apiSecret
 
 HTTPSession::~HTTPSession() = default;
 
+void HTTPSession::setClockSync(const std::shared_ptr<ClockSync> &clockSync) const {
+    m_p->clockSync = clockSync;
+}
+
+void HTTPSession::setReceiveWindow(const int receiveWindow) const {
+    m_p->receiveWindow = receiveWindow;
+}
+
+http::response<http::string_body> HTTPSession::methodGetTimed(const std::string &path, std::int64_t &requestTime,
+                                                              std::int64_t &responseTime) const {
+    std::map<std::string, std::string> parameters;
+    const auto req = m_p->createRequest(http::verb::get, path, parameters, true);
+    return m_p->request(req, &requestTime, &responseTime);
+}
+
 http::response<http::string_body> HTTPSession::methodGet(const std::string &path,
                                                          std::map<std::string, std::string> &parameters,
                                                          const bool isPublic) const {
@@ -128,7 +150,7 @@ http::response<http::string_body> HTTPSession::methodDelete(const std::string &p
 }
 
 http::response<http::string_body> HTTPSession::P::request(
-    http::request<http::string_body> req) {
+    http::request<http::string_body> req, std::int64_t *requestTime, std::int64_t *responseTime) {
     req.set(http::field::host, uri);
     req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
 
@@ -155,11 +177,19 @@ http::response<http::string_body> HTTPSession::P::request(
         req.set(http::field::content_type, "application/json");
     }
 
+    if (requestTime) {
+        *requestTime = getMsTimestamp(currentTime()).count();
+    }
+
     http::write(stream, req);
     beast::flat_buffer buffer;
     http::response<http::string_body> response;
     http::read(stream, buffer, response);
 
+    if (responseTime) {
+        *responseTime = getMsTimestamp(currentTime()).count();
+    }
+
     boost::system::error_code ec;
     stream.shutdown(ec);
     if (ec == boost::asio::error::eof) {
@@ -9,6 +9,10 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include "vk/mexc/mexc_models.h"
 #include "vk/utils/utils.h"
 #include "vk/utils/json_utils.h"
+#include "vk/mexc/mexc_json_fields.h"
+#include <algorithm>
+#include <charconv>
+#include <numeric>
 
 namespace vk::mexc::spot {
 nlohmann::json Response::toJson() const {
@@ -60,6 +64,100 @@ void TickerPrice::fromJson(const nlohmann::json &json) {
     price.assign(json["price"].get<std::string>());
 }
 
+std::optional<std::size_t> TickerPriceSnapshot::indexOf(const std::string_view symbol) const {
+    if (const auto it = std::ranges::lower_bound(symbols, symbol, {}, [](const std::string &s) { return std::string_view(s); });
+        it != symbols.end() && *it == symbol) {
+        return static_cast<std::size_t>(it - symbols.begin());
+    }
+
+    return {};
+}
+
+std::optional<double> TickerPriceSnapshot::price(const std::string_view symbol) const {
+    if (const auto index = indexOf(symbol)) {
+        return prices[*index];
+    }
+
+    return {};
+}
+
+TickerPriceSnapshot::Diff TickerPriceSnapshot::diff(const TickerPriceSnapshot &previous) const {
+    Diff retVal;
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    while (i < symbols.size() && j < previous.symbols.size()) {
+        if (const auto cmp = symbols[i].compare(previous.symbols[j]); cmp == 0) {
+            if (prices[i] != previous.prices[j]) {
+                retVal.changed.push_back({i, previous.prices[j], prices[i]});
+            }
+            ++i;
+            ++j;
+        } else if (cmp < 0) {
+            retVal.added.push_back(i++);
+        } else {
+            retVal.removed.push_back(previous.symbols[j++]);
+        }
+    }
+
+    for (; i < symbols.size(); ++i) {
+        retVal.added.push_back(i);
+    }
+
+    for (; j < previous.symbols.size(); ++j) {
+        retVal.removed.push_back(previous.symbols[j]);
+    }
+
+    return retVal;
+}
+
+nlohmann::json TickerPriceSnapshot::toJson() const {
+    throw std::runtime_error("Unimplemented: TickerPriceSnapshot::toJson()");
+}
+
+void TickerPriceSnapshot::fromJson(const nlohmann::json &json) {
+    symbols.clear();
+    prices.clear();
+
+    if (!json.is_array()) {
+        Response::fromJson(json);
+        return;
+    }
+
+    std::vector<std::string> unsortedSymbols;
+    std::vector<double> unsortedPrices;
+    unsortedSymbols.reserve(json.size());
+    unsortedPrices.reserve(json.size());
+
+    for (const auto &el: json) {
+        const auto &symbol = el["symbol"].get_ref<const std::string &>();
+        const auto &priceStr = el["price"].get_ref<const std::string &>();
+        double value = 0.0;
+
+        if (const auto [ptr, ec] = std::from_chars(priceStr.data(), priceStr.data() + priceStr.size(), value);
+            ec != std::errc()) {
+            throw std::runtime_error("Invalid price for symbol: " + symbol);
+        }
+
+        unsortedSymbols.push_back(symbol);
+        unsortedPrices.push_back(value);
+    }
+
+    std::vector<std::size_t> order(unsortedSymbols.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](const std::size_t a, const std::size_t b) {
+        return unsortedSymbols[a] < unsortedSymbols[b];
+    });
+
+    symbols.reserve(order.size());
+    prices.reserve(order.size());
+
+    for (const auto index: order) {
+        symbols.push_back(std::move(unsortedSymbols[index]));
+        prices.push_back(unsortedPrices[index]);
+    }
+}
+
 nlohmann::json ListenKey::toJson() const {
     throw std::runtime_error("Unimplemented: ListenKey::toJson()");
 }
@@ -82,6 +180,125 @@ void ListenKeys::fromJson(const nlohmann::json &json) {
 }
 
 namespace vk::mexc::futures {
+namespace {
+constexpr auto HISTORICAL_FUNDING_RATE_FIELDS = makeJsonFieldTable<HistoricalFundingRate>(
+    jsonField<&HistoricalFundingRate::symbol>("symbol"),
+    jsonField<&HistoricalFundingRate::fundingRate>("fundingRate"),
+    jsonField<&HistoricalFundingRate::settleTime>("settleTime"));
+
+/// The levels of a DOM are read through their text, so both paths parse the same tokens
+void readDepthLevels(const nlohmann::json &value, std::vector<DepthLevel> &levels) {
+    const auto dump = value.dump();
+    JsonScanner scanner(dump);
+    readDepthLevels(scanner, levels);
+}
+
+constexpr auto DEPTH_FIELDS = makeJsonFieldTable<Depth>(
+    jsonField<&Depth::version>("version"),
+    jsonField<&Depth::timestamp>("timestamp"),
+    customJsonField<Depth>(
+        "asks", [](const nlohmann::json &value, Depth &target) {
+            readDepthLevels(value, target.asks);
+        },
+        [](JsonScanner &scanner, Depth &target) {
+            readDepthLevels(scanner, target.asks);
+        }),
+    customJsonField<Depth>(
+        "bids", [](const nlohmann::json &value, Depth &target) {
+            readDepthLevels(value, target.bids);
+        },
+        [](JsonScanner &scanner, Depth &target) {
+            readDepthLevels(scanner, target.bids);
+        }));
+
+constexpr auto FUNDING_RATE_FIELDS = makeJsonFieldTable<FundingRate>(
+    jsonField<&FundingRate::symbol>("symbol"),
+    jsonField<&FundingRate::fundingRate>("fundingRate"),
+    jsonField<&FundingRate::maxFundingRate>("maxFundingRate"),
+    jsonField<&FundingRate::minFundingRate>("minFundingRate"),
+    jsonField<&FundingRate::collectCycle>("collectCycle"),
+    jsonField<&FundingRate::nextSettleTime>("nextSettleTime"),
+    jsonField<&FundingRate::timestamp>("timestamp"));
+
+constexpr auto TICKER_FIELDS = makeJsonFieldTable<Ticker>(
+    jsonField<&Ticker::symbol>("symbol"),
+    jsonField<&Ticker::lastPrice>("lastPrice"),
+    jsonField<&Ticker::bid1>("bid1"),
+    jsonField<&Ticker::ask1>("ask1"),
+    jsonField<&Ticker::volume24>("volume24"),
+    jsonField<&Ticker::amount24>("amount24"),
+    jsonField<&Ticker::holdVol>("holdVol"),
+    jsonField<&Ticker::timestamp>("timestamp"));
+
+constexpr auto OPEN_POSITION_FIELDS = makeJsonFieldTable<OpenPosition>(
+    jsonField<&OpenPosition::positionId>("positionId"),
+    jsonField<&OpenPosition::symbol>("symbol"),
+    jsonField<&OpenPosition::positionType>("positionType"),
+    jsonField<&OpenPosition::openType>("openType"),
+    jsonField<&OpenPosition::state>("state"),
+    jsonField<&OpenPosition::holdVol>("holdVol"),
+    jsonField<&OpenPosition::frozenVol>("frozenVol"),
+    jsonField<&OpenPosition::holdAvgPrice>("holdAvgPrice"),
+    jsonField<&OpenPosition::openAvgPrice>("openAvgPrice"),
+    jsonField<&OpenPosition::liquidatePrice>("liquidatePrice"),
+    jsonField<&OpenPosition::oim>("oim"),
+    jsonField<&OpenPosition::im>("im"),
+    jsonField<&OpenPosition::holdFee>("holdFee"),
+    jsonField<&OpenPosition::realised>("realised"),
+    jsonField<&OpenPosition::leverage>("leverage"),
+    jsonField<&OpenPosition::createTime>("createTime"),
+    jsonField<&OpenPosition::updateTime>("updateTime"));
+
+constexpr auto PMR_CONTRACT_DETAIL_FIELDS = makeJsonFieldTable<PmrContractDetail>(
+    jsonField<&PmrContractDetail::symbol>("symbol"),
+    jsonField<&PmrContractDetail::displayNameEn>("displayNameEn"),
+    jsonField<&PmrContractDetail::baseCoin>("baseCoin"),
+    jsonField<&PmrContractDetail::quoteCoin>("quoteCoin"),
+    jsonField<&PmrContractDetail::settleCoin>("settleCoin"),
+    jsonField<&PmrContractDetail::state>("state"),
+    jsonField<&PmrContractDetail::apiAllowed>("apiAllowed"),
+    jsonField<&PmrContractDetail::automaticDelivery>("automaticDelivery"),
+    jsonField<&PmrContractDetail::contractSize>("contractSize"),
+    jsonField<&PmrContractDetail::minVol>("minVol"),
+    jsonField<&PmrContractDetail::maxVol>("maxVol"),
+    jsonField<&PmrContractDetail::volUnit>("volUnit"),
+    jsonField<&PmrContractDetail::priceUnit>("priceUnit"),
+    jsonField<&PmrContractDetail::pricePrecision>("pricePrecision"),
+    jsonField<&PmrContractDetail::volPrecision>("volPrecision"),
+    jsonField<&PmrContractDetail::conceptPlate>("conceptPlate"));
+
+/// Reads the {success, code, data} envelope of a futures response, data is handed to scanData
+template<typename ScanData>
+void scanResponse(JsonScanner &scanner, Response &response, ScanData &&scanData) {
+    scanner.readObject([&](const std::string_view key) {
+        if (key == "success") {
+            response.success = scanner.readBool();
+        } else if (key == "code") {
+            response.code = static_cast<int>(scanner.readInt());
+        } else if (key == "data") {
+            scanData();
+        } else {
+            scanner.skipValue();
+        }
+    });
+}
+
+/// Reads an array of objects described by fields, anything but an array leaves items empty
+template<typename T, std::size_t N>
+void scanObjectArray(JsonScanner &scanner, const JsonFieldTable<T, N> &fields, std::vector<T> &items) {
+    items.clear();
+
+    if (scanner.peek() != '[') {
+        scanner.skipValue();
+        return;
+    }
+
+    scanner.readArray([&] {
+        fields.scan(scanner, items.emplace_back());
+    });
+}
+}
+
 nlohmann::json Response::toJson() const {
     throw std::runtime_error("Unimplemented: Response::toJson()");
 }
@@ -110,30 +327,13 @@ nlohmann::json FundingRate::toJson() const {
 
 void FundingRate::fromJson(const nlohmann::json &json) {
     Response::fromJson(json);
-    readValue<std::string>(data, "symbol", symbol);
-
-    // MEXC API returns funding rates as numbers, not strings
-    if (data.contains("fundingRate") && data["fundingRate"].is_number()) {
-        fundingRate.assign(std::to_string(data["fundingRate"].get<double>()));
-    } else {
-        fundingRate = readDecimalValue(data, "fundingRate");
-    }
-
-    if (data.contains("maxFundingRate") && data["maxFundingRate"].is_number()) {
-        maxFundingRate.assign(std::to_string(data["maxFundingRate"].get<double>()));
-    } else {
-        maxFundingRate = readDecimalValue(data, "maxFundingRate");
-    }
-
-    if (data.contains("minFundingRate") && data["minFundingRate"].is_number()) {
-        minFundingRate.assign(std::to_string(data["minFundingRate"].get<double>()));
-    } else {
-        minFundingRate = readDecimalValue(data, "minFundingRate");
-    }
+    FUNDING_RATE_FIELDS.read(data, *this);
+}
 
-    readValue<int>(data, "collectCycle", collectCycle);
-    readValue<std::int64_t>(data, "nextSettleTime", nextSettleTime);
-    readValue<std::int64_t>(data, "timestamp", timestamp);
+void FundingRate::fromJson(JsonScanner &scanner) {
+    scanResponse(scanner, *this, [&] {
+        FUNDING_RATE_FIELDS.scan(scanner, *this);
+    });
 }
 
 nlohmann::json FundingRates::toJson() const {
@@ -152,21 +352,18 @@ void FundingRates::fromJson(const nlohmann::json &json) {
     }
 }
 
+void FundingRates::fromJson(JsonScanner &scanner) {
+    scanResponse(scanner, *this, [&] {
+        scanObjectArray(scanner, FUNDING_RATE_FIELDS, fundingRates);
+    });
+}
+
 nlohmann::json HistoricalFundingRate::toJson() const {
     throw std::runtime_error("Unimplemented: HistoricalFundingRate::toJson()");
 }
 
 void HistoricalFundingRate::fromJson(const nlohmann::json &json) {
-    readValue<std::string>(json, "symbol", symbol);
-
-    // MEXC API returns funding rates as numbers
-    if (json.contains("fundingRate") && json["fundingRate"].is_number()) {
-        fundingRate.assign(std::to_string(json["fundingRate"].get<double>()));
-    } else {
-        fundingRate = readDecimalValue(json, "fundingRate");
-    }
-
-    readValue<std::int64_t>(json, "settleTime", settleTime);
+    HISTORICAL_FUNDING_RATE_FIELDS.read(json, *this);
 }
 
 nlohmann::json HistoricalFundingRates::toJson() const {
@@ -174,20 +371,36 @@ nlohmann::json HistoricalFundingRates::toJson() const {
 }
 
 void HistoricalFundingRates::fromJson(const nlohmann::json &json) {
-    Response::fromJson(json);
-
-    readValue<std::int32_t>(data, "pageSize", pageSize);
-    readValue<std::int32_t>(data, "totalCount", totalCount);
-    readValue<std::int32_t>(data, "totalPage", totalPage);
-    readValue<std::int32_t>(data, "currentPage", currentPage);
+    static constexpr auto FIELDS = makeJsonFieldTable<HistoricalFundingRates>(
+        jsonField<&HistoricalFundingRates::pageSize>("pageSize"),
+        jsonField<&HistoricalFundingRates::totalCount>("totalCount"),
+        jsonField<&HistoricalFundingRates::totalPage>("totalPage"),
+        jsonField<&HistoricalFundingRates::currentPage>("currentPage"),
+        customJsonField<HistoricalFundingRates>(
+            "resultList", [](const nlohmann::json &value, HistoricalFundingRates &target) {
+                if (value.is_array()) {
+                    target.resultList.resize(value.size());
+
+                    for (std::size_t i = 0; i < value.size(); ++i) {
+                        target.resultList[i].fromJson(value[i]);
+                    }
+                }
+            },
+            [](JsonScanner &scanner, HistoricalFundingRates &target) {
+                target.resultList.clear();
+
+                if (scanner.peek() != '[') {
+                    scanner.skipValue();
+                    return;
+                }
+
+                scanner.readArray([&] {
+                    HISTORICAL_FUNDING_RATE_FIELDS.scan(scanner, target.resultList.emplace_back());
+                });
+            }));
 
-    if (data.contains("resultList") && data["resultList"].is_array()) {
-        for (const auto &item : data["resultList"]) {
-            HistoricalFundingRate rate;
-            rate.fromJson(item);
-            resultList.push_back(rate);
-        }
-    }
+    Response::fromJson(json);
+    FIELDS.read(data, *this);
 }
 
 [[nodiscard]] nlohmann::json WalletBalance::toJson() const {
@@ -195,15 +408,18 @@ void HistoricalFundingRates::fromJson(const nlohmann::json &json) {
 }
 
 void WalletBalance::fromJson(const nlohmann::json &json) {
+    static constexpr auto FIELDS = makeJsonFieldTable<WalletBalance>(
+        jsonField<&WalletBalance::currency>("currency"),
+        jsonField<&WalletBalance::positionMargin>("positionMargin"),
+        jsonField<&WalletBalance::availableBalance>("availableBalance"),
+        jsonField<&WalletBalance::cashBalance>("cashBalance"),
+        jsonField<&WalletBalance::frozenBalance>("frozenBalance"),
+        jsonField<&WalletBalance::equity>("equity"),
+        jsonField<&WalletBalance::unrealized>("unrealized"),
+        jsonField<&WalletBalance::bonus>("bonus"));
+
     Response::fromJson(json);
-    readValue<std::string>(data, "currency", currency);
-    positionMargin = readDecimalValue(data, "positionMargin");
-    availableBalance = readDecimalValue(data, "availableBalance");
-    cashBalance = readDecimalValue(data, "cashBalance");
-    frozenBalance = readDecimalValue(data, "frozenBalance");
-    equity = readDecimalValue(data, "equity");
-    unrealized = readDecimalValue(data, "unrealized");
-    bonus = readDecimalValue(data, "bonus");
+    FIELDS.read(data, *this);
 }
 
 nlohmann::json Ticker::toJson() const {
@@ -212,45 +428,58 @@ nlohmann::json Ticker::toJson() const {
 
 void Ticker::fromJson(const nlohmann::json &json) {
     Response::fromJson(json);
-    readValue<std::string>(data, "symbol", symbol);
+    TICKER_FIELDS.read(data, *this);
+}
 
-    if (data.contains("lastPrice") && data["lastPrice"].is_number()) {
-        lastPrice.assign(std::to_string(data["lastPrice"].get<double>()));
-    } else {
-        lastPrice = readDecimalValue(data, "lastPrice");
-    }
+void Ticker::fromJson(JsonScanner &scanner) {
+    scanResponse(scanner, *this, [&] {
+        TICKER_FIELDS.scan(scanner, *this);
+    });
+}
 
-    if (data.contains("bid1") && data["bid1"].is_number()) {
-        bid1.assign(std::to_string(data["bid1"].get<double>()));
-    } else {
-        bid1 = readDecimalValue(data, "bid1");
-    }
+nlohmann::json Depth::toJson() const {
+    throw std::runtime_error("Unimplemented: Depth::toJson()");
+}
 
-    if (data.contains("ask1") && data["ask1"].is_number()) {
-        ask1.assign(std::to_string(data["ask1"].get<double>()));
-    } else {
-        ask1 = readDecimalValue(data, "ask1");
-    }
+void readDepthLevels(JsonScanner &scanner, std::vector<DepthLevel> &levels) {
+    levels.clear();
 
-    if (data.contains("volume24") && data["volume24"].is_number()) {
-        volume24.assign(std::to_string(data["volume24"].get<double>()));
-    } else {
-        volume24 = readDecimalValue(data, "volume24");
+    if (scanner.peek() != '[') {
+        scanner.skipValue();
+        return;
     }
 
-    if (data.contains("amount24") && data["amount24"].is_number()) {
-        amount24.assign(std::to_string(data["amount24"].get<double>()));
-    } else {
-        amount24 = readDecimalValue(data, "amount24");
-    }
+    scanner.readArray([&] {
+        auto &level = levels.emplace_back();
+        std::size_t index = 0;
+
+        scanner.readArray([&] {
+            switch (index++) {
+            case 0:
+                level.price.assign(scanner.readToken());
+                break;
+            case 1:
+                level.volume.assign(scanner.readToken());
+                break;
+            case 2:
+                level.orderCount = static_cast<std::int32_t>(scanner.readInt());
+                break;
+            default:
+                scanner.skipValue();
+            }
+        });
+    });
+}
 
-    if (data.contains("holdVol") && data["holdVol"].is_number()) {
-        holdVol.assign(std::to_string(data["holdVol"].get<double>()));
-    } else {
-        holdVol = readDecimalValue(data, "holdVol");
-    }
+void Depth::fromJson(const nlohmann::json &json) {
+    Response::fromJson(json);
+    DEPTH_FIELDS.read(data, *this);
+}
 
-    readValue<std::int64_t>(data, "timestamp", timestamp);
+void Depth::fromJson(JsonScanner &scanner) {
+    scanResponse(scanner, *this, [&] {
+        DEPTH_FIELDS.scan(scanner, *this);
+    });
 }
 
 nlohmann::json OpenPosition::toJson() const {
@@ -258,69 +487,11 @@ nlohmann::json OpenPosition::toJson() const {
 }
 
 void OpenPosition::fromJson(const nlohmann::json &json) {
-    readValue<std::int64_t>(json, "positionId", positionId);
-    readValue<std::string>(json, "symbol", symbol);
-    readValue<std::int32_t>(json, "positionType", positionType);
-    readValue<std::int32_t>(json, "openType", openType);
-    readValue<std::int32_t>(json, "state", state);
-
-    if (json.contains("holdVol") && json["holdVol"].is_number()) {
-        holdVol.assign(std::to_string(json["holdVol"].get<double>()));
-    } else {
-        holdVol = readDecimalValue(json, "holdVol");
-    }
-
-    if (json.contains("frozenVol") && json["frozenVol"].is_number()) {
-        frozenVol.assign(std::to_string(json["frozenVol"].get<double>()));
-    } else {
-        frozenVol = readDecimalValue(json, "frozenVol");
-    }
-
-    if (json.contains("holdAvgPrice") && json["holdAvgPrice"].is_number()) {
-        holdAvgPrice.assign(std::to_string(json["holdAvgPrice"].get<double>()));
-    } else {
-        holdAvgPrice = readDecimalValue(json, "holdAvgPrice");
-    }
-
-    if (json.contains("openAvgPrice") && json["openAvgPrice"].is_number()) {
-        openAvgPrice.assign(std::to_string(json["openAvgPrice"].get<double>()));
-    } else {
-        openAvgPrice = readDecimalValue(json, "openAvgPrice");
-    }
-
-    if (json.contains("liquidatePrice") && json["liquidatePrice"].is_number()) {
-        liquidatePrice.assign(std::to_string(json["liquidatePrice"].get<double>()));
-    } else {
-        liquidatePrice = readDecimalValue(json, "liquidatePrice");
-    }
-
-    if (json.contains("oim") && json["oim"].is_number()) {
-        oim.assign(std::to_string(json["oim"].get<double>()));
-    } else {
-        oim = readDecimalValue(json, "oim");
-    }
-
-    if (json.contains("im") && json["im"].is_number()) {
-        im.assign(std::to_string(json["im"].get<double>()));
-    } else {
-        im = readDecimalValue(json, "im");
-    }
-
-    if (json.contains("holdFee") && json["holdFee"].is_number()) {
-        holdFee.assign(std::to_string(json["holdFee"].get<double>()));
-    } else {
-        holdFee = readDecimalValue(json, "holdFee");
-    }
-
-    if (json.contains("realised") && json["realised"].is_number()) {
-        realised.assign(std::to_string(json["realised"].get<double>()));
-    } else {
-        realised = readDecimalValue(json, "realised");
-    }
+    OPEN_POSITION_FIELDS.read(json, *this);
+}
 
-    readValue<std::int32_t>(json, "leverage", leverage);
-    readValue<std::int64_t>(json, "createTime", createTime);
-    readValue<std::int64_t>(json, "updateTime", updateTime);
+void OpenPosition::fromJson(JsonScanner &scanner) {
+    OPEN_POSITION_FIELDS.scan(scanner, *this);
 }
 
 nlohmann::json OpenPositions::toJson() const {
@@ -339,6 +510,12 @@ void OpenPositions::fromJson(const nlohmann::json &json) {
     }
 }
 
+void OpenPositions::fromJson(JsonScanner &scanner) {
+    scanResponse(scanner, *this, [&] {
+        scanObjectArray(scanner, OPEN_POSITION_FIELDS, positions);
+    });
+}
+
 nlohmann::json OrderRequest::toJson() const {
     nlohmann::json j;
     j["symbol"] = symbol;
@@ -391,11 +568,36 @@ void CancelOrderResponse::fromJson(const nlohmann::json &json) {
     Response::fromJson(json);
 
     if (data.is_array()) {
+        static constexpr auto FIELDS = makeJsonFieldTable<Result>(
+            jsonField<&Result::orderId>("orderId"),
+            jsonField<&Result::errorCode>("errorCode"),
+            jsonField<&Result::errorMsg>("errorMsg"));
+
+        for (const auto &item : data) {
+            Result r;
+            FIELDS.read(item, r);
+            results.push_back(r);
+        }
+    }
+}
+
+nlohmann::json BatchOrderResponse::toJson() const {
+    throw std::runtime_error("Unimplemented: BatchOrderResponse::toJson()");
+}
+
+void BatchOrderResponse::fromJson(const nlohmann::json &json) {
+    Response::fromJson(json);
+
+    if (data.is_array()) {
+        static constexpr auto FIELDS = makeJsonFieldTable<Result>(
+            jsonField<&Result::orderId>("orderId"),
+            jsonField<&Result::externalOid>("externalOid"),
+            jsonField<&Result::errorCode>("errorCode"),
+            jsonField<&Result::errorMsg>("errorMsg"));
+
         for (const auto &item : data) {
             Result r;
-            readValue<std::int64_t>(item, "orderId", r.orderId);
-            readValue<std::int32_t>(item, "errorCode", r.errorCode);
-            readValue<std::string>(item, "errorMsg", r.errorMsg);
+            FIELDS.read(item, r);
             results.push_back(r);
         }
     }
@@ -415,34 +617,66 @@ nlohmann::json Candles::toJson() const {
 }
 
 void Candles::fromJson(const nlohmann::json &json) {
-    Response::fromJson(json);
+    const auto dump = json.dump();
+    JsonScanner scanner(dump);
+    fromJson(scanner);
+}
 
-    if (!data.contains("time") || data["time"].empty()) {
-        return;
-    }
+void Candles::fromJson(JsonScanner &scanner) {
+    // data holds one array per column, the candle of index i is assembled from the i-th element of each
+    const auto readColumn = [&](auto assign) {
+        std::size_t i = 0;
 
-    const auto &times = data["time"];
-    const auto &opens = data["open"];
-    const auto &highs = data["high"];
-    const auto &lows = data["low"];
-    const auto &closes = data["close"];
-    const auto &vols = data["vol"];
-    const auto &amounts = data["amount"];
-
-    const size_t count = times.size();
-    candles.reserve(count);
-
-    for (size_t i = 0; i < count; ++i) {
-        Candle candle;
-        candle.openTime = times[i].get<std::int64_t>() * 1000; // Convert seconds to ms
-        candle.open.assign(std::to_string(opens[i].get<double>()));
-        candle.high.assign(std::to_string(highs[i].get<double>()));
-        candle.low.assign(std::to_string(lows[i].get<double>()));
-        candle.close.assign(std::to_string(closes[i].get<double>()));
-        candle.volume.assign(std::to_string(vols[i].get<double>()));
-        candle.amount.assign(std::to_string(amounts[i].get<double>()));
-        candles.push_back(candle);
-    }
+        scanner.readArray([&] {
+            if (i == candles.size()) {
+                candles.emplace_back();
+            }
+
+            assign(candles[i++]);
+        });
+    };
+
+    const auto readDecimalColumn = [&](auto member) {
+        readColumn([&](Candle &candle) {
+            (candle.*member).assign(scanner.readToken());
+        });
+    };
+
+    scanner.readObject([&](const std::string_view key) {
+        if (key == "success") {
+            success = scanner.readBool();
+        } else if (key == "code") {
+            code = static_cast<int>(scanner.readInt());
+        } else if (key == "data" && scanner.peek() == '{') {
+            scanner.readObject([&](const std::string_view column) {
+                if (scanner.readNull()) {
+                    return;
+                }
+
+                if (column == "time") {
+                    readColumn([&](Candle &candle) {
+                        candle.openTime = scanner.readInt() * 1000; // Convert seconds to ms
+                    });
+                } else if (column == "open") {
+                    readDecimalColumn(&Candle::open);
+                } else if (column == "high") {
+                    readDecimalColumn(&Candle::high);
+                } else if (column == "low") {
+                    readDecimalColumn(&Candle::low);
+                } else if (column == "close") {
+                    readDecimalColumn(&Candle::close);
+                } else if (column == "vol") {
+                    readDecimalColumn(&Candle::volume);
+                } else if (column == "amount") {
+                    readDecimalColumn(&Candle::amount);
+                } else {
+                    scanner.skipValue();
+                }
+            });
+        } else {
+            scanner.skipValue();
+        }
+    });
 }
 
 nlohmann::json ContractDetail::toJson() const {
@@ -450,32 +684,25 @@ nlohmann::json ContractDetail::toJson() const {
 }
 
 void ContractDetail::fromJson(const nlohmann::json &json) {
-    readValue<std::string>(json, "symbol", symbol);
-    readValue<std::string>(json, "displayNameEn", displayNameEn);
-    readValue<std::string>(json, "baseCoin", baseCoin);
-    readValue<std::string>(json, "quoteCoin", quoteCoin);
-    readValue<std::string>(json, "settleCoin", settleCoin);
-    readValue<bool>(json, "apiAllowed", apiAllowed);
-    readValue<std::int32_t>(json, "automaticDelivery", automaticDelivery);
-    readValue<double>(json, "contractSize", contractSize);
-    readValue<std::int32_t>(json, "minVol", minVol);
-    readValue<std::int32_t>(json, "maxVol", maxVol);
-    readValue<std::int32_t>(json, "volUnit", volUnit);
-    readValue<std::int32_t>(json, "priceUnit", priceUnit);
-    readValue<std::int32_t>(json, "pricePrecision", pricePrecision);
-    readValue<std::int32_t>(json, "volPrecision", volPrecision);
-
-    if (json.contains("state") && json["state"].is_number()) {
-        state = static_cast<ContractState>(json["state"].get<std::int32_t>());
-    }
-
-    if (json.contains("conceptPlate") && json["conceptPlate"].is_array()) {
-        for (const auto &item : json["conceptPlate"]) {
-            if (item.is_string()) {
-                conceptPlate.push_back(item.get<std::string>());
-            }
-        }
-    }
+    static constexpr auto FIELDS = makeJsonFieldTable<ContractDetail>(
+        jsonField<&ContractDetail::symbol>("symbol"),
+        jsonField<&ContractDetail::displayNameEn>("displayNameEn"),
+        jsonField<&ContractDetail::baseCoin>("baseCoin"),
+        jsonField<&ContractDetail::quoteCoin>("quoteCoin"),
+        jsonField<&ContractDetail::settleCoin>("settleCoin"),
+        jsonField<&ContractDetail::state>("state"),
+        jsonField<&ContractDetail::apiAllowed>("apiAllowed"),
+        jsonField<&ContractDetail::automaticDelivery>("automaticDelivery"),
+        jsonField<&ContractDetail::contractSize>("contractSize"),
+        jsonField<&ContractDetail::minVol>("minVol"),
+        jsonField<&ContractDetail::maxVol>("maxVol"),
+        jsonField<&ContractDetail::volUnit>("volUnit"),
+        jsonField<&ContractDetail::priceUnit>("priceUnit"),
+        jsonField<&ContractDetail::pricePrecision>("pricePrecision"),
+        jsonField<&ContractDetail::volPrecision>("volPrecision"),
+        jsonField<&ContractDetail::conceptPlate>("conceptPlate"));
+
+    FIELDS.read(json, *this);
 }
 
 nlohmann::json ContractDetails::toJson() const {
@@ -493,4 +720,160 @@ void ContractDetails::fromJson(const nlohmann::json &json) {
         }
     }
 }
+
+PmrContractDetail::PmrContractDetail(const allocator_type &allocator) : symbol(allocator),
+                                                                        displayNameEn(allocator),
+                                                                        baseCoin(allocator),
+                                                                        quoteCoin(allocator),
+                                                                        settleCoin(allocator),
+                                                                        conceptPlate(allocator) {
+}
+
+PmrContractDetail::PmrContractDetail(const PmrContractDetail &other,
+                                     const allocator_type &allocator) : symbol(other.symbol, allocator),
+                                                                        displayNameEn(other.displayNameEn, allocator),
+                                                                        baseCoin(other.baseCoin, allocator),
+                                                                        quoteCoin(other.quoteCoin, allocator),
+                                                                        settleCoin(other.settleCoin, allocator),
+                                                                        state(other.state),
+                                                                        apiAllowed(other.apiAllowed),
+                                                                        automaticDelivery(other.automaticDelivery),
+                                                                        contractSize(other.contractSize),
+                                                                        minVol(other.minVol),
+                                                                        maxVol(other.maxVol),
+                                                                        volUnit(other.volUnit),
+                                                                        priceUnit(other.priceUnit),
+                                                                        pricePrecision(other.pricePrecision),
+                                                                        volPrecision(other.volPrecision),
+                                                                        conceptPlate(other.conceptPlate, allocator) {
+}
+
+PmrContractDetail::PmrContractDetail(PmrContractDetail &&other,
+                                     const allocator_type &allocator) : symbol(std::move(other.symbol), allocator),
+                                                                        displayNameEn(std::move(other.displayNameEn),
+                                                                                      allocator),
+                                                                        baseCoin(std::move(other.baseCoin), allocator),
+                                                                        quoteCoin(std::move(other.quoteCoin), allocator),
+                                                                        settleCoin(std::move(other.settleCoin), allocator),
+                                                                        state(other.state),
+                                                                        apiAllowed(other.apiAllowed),
+                                                                        automaticDelivery(other.automaticDelivery),
+                                                                        contractSize(other.contractSize),
+                                                                        minVol(other.minVol),
+                                                                        maxVol(other.maxVol),
+                                                                        volUnit(other.volUnit),
+                                                                        priceUnit(other.priceUnit),
+                                                                        pricePrecision(other.pricePrecision),
+                                                                        volPrecision(other.volPrecision),
+                                                                        conceptPlate(std::move(other.conceptPlate),
+                                                                                     allocator) {
+}
+
+void PmrContractDetail::fromJson(const nlohmann::json &json) {
+    PMR_CONTRACT_DETAIL_FIELDS.read(json, *this);
+}
+
+void PmrContractDetail::fromJson(JsonScanner &scanner) {
+    PMR_CONTRACT_DETAIL_FIELDS.scan(scanner, *this);
+}
+
+ContractDetail PmrContractDetail::toContractDetail() const {
+    ContractDetail retVal;
+    retVal.symbol.assign(symbol);
+    retVal.displayNameEn.assign(displayNameEn);
+    retVal.baseCoin.assign(baseCoin);
+    retVal.quoteCoin.assign(quoteCoin);
+    retVal.settleCoin.assign(settleCoin);
+    retVal.state = state;
+    retVal.apiAllowed = apiAllowed;
+    retVal.automaticDelivery = automaticDelivery;
+    retVal.contractSize = contractSize;
+    retVal.minVol = minVol;
+    retVal.maxVol = maxVol;
+    retVal.volUnit = volUnit;
+    retVal.priceUnit = priceUnit;
+    retVal.pricePrecision = pricePrecision;
+    retVal.volPrecision = volPrecision;
+    retVal.conceptPlate.reserve(conceptPlate.size());
+
+    for (const auto &plate: conceptPlate) {
+        retVal.conceptPlate.emplace_back(plate);
+    }
+
+    return retVal;
+}
+
+void *PmrContractDetails::UpstreamCounter::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    allocated += bytes;
+    return m_upstream->allocate(bytes, alignment);
+}
+
+void PmrContractDetails::UpstreamCounter::do_deallocate(void *p, const std::size_t bytes,
+                                                        const std::size_t alignment) {
+    m_upstream->deallocate(p, bytes, alignment);
+}
+
+bool PmrContractDetails::UpstreamCounter::do_is_equal(const memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+PmrContractDetails::PmrContractDetails(const std::size_t initialSize,
+                                       std::pmr::memory_resource *upstream)
+    : m_upstream(upstream),
+      m_buffer(std::max<std::size_t>(initialSize, 1), upstream),
+      m_arena(std::in_place, m_buffer.data(), m_buffer.size(), &m_upstream),
+      contractDetails(&*m_arena) {
+}
+
+void PmrContractDetails::clear() {
+    /// The old storage is destroyed with the temporary before the arena is released
+    std::pmr::vector<PmrContractDetail>(&*m_arena).swap(contractDetails);
+    m_arena->release();
+
+    if (m_upstream.allocated == 0) {
+        return;
+    }
+
+    /// The arena is rebuilt in place, so contractDetails keeps pointing at it
+    const auto highWaterMark = m_buffer.size() + m_upstream.allocated;
+    m_upstream.allocated = 0;
+    m_arena.reset();
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_buffer.resize(highWaterMark);
+    m_arena.emplace(m_buffer.data(), m_buffer.size(), &m_upstream);
+}
+
+void PmrContractDetails::fromJson(const nlohmann::json &json) {
+    clear();
+    readValue<int>(json, "code", code);
+    readValue<bool>(json, "success", success);
+
+    /// data is not copied as in Response::fromJson, the details are read from the parsed document directly
+    if (const auto it = json.find("data"); it != json.end() && it->is_array()) {
+        contractDetails.reserve(it->size());
+
+        for (const auto &item: *it) {
+            contractDetails.emplace_back().fromJson(item);
+        }
+    }
+}
+
+void PmrContractDetails::fromJson(JsonScanner &scanner) {
+    clear();
+
+    scanner.readObject([&](const std::string_view key) {
+        if (key == "success") {
+            success = scanner.readBool();
+        } else if (key == "code") {
+            code = static_cast<int>(scanner.readInt());
+        } else if (key == "data" && scanner.peek() == '[') {
+            scanner.readArray([&] {
+                contractDetails.emplace_back().fromJson(scanner);
+            });
+        } else {
+            scanner.skipValue();
+        }
+    });
+}
 }
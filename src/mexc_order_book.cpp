@@ -0,0 +1,309 @@
+/**
+MEXC Order Book
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_order_book.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace vk::mexc::futures {
+namespace {
+/// Updates buffered while waiting for a snapshot, the oldest are dropped beyond it
+constexpr std::size_t MAX_BUFFERED_UPDATES = 10000;
+
+/// Level readable concurrently with the writer, the fields are atomics so the torn reads are not data races
+struct PublishedLevel {
+    std::atomic<std::int64_t> priceMantissa{};
+    std::atomic<std::int64_t> volumeMantissa{};
+    std::atomic<std::int32_t> priceExponent{};
+    std::atomic<std::int32_t> volumeExponent{};
+    std::atomic<std::int32_t> orderCount{};
+
+    void store(const DepthLevel &level) {
+        priceMantissa.store(level.price.mantissa(), std::memory_order_relaxed);
+        priceExponent.store(level.price.exponent(), std::memory_order_relaxed);
+        volumeMantissa.store(level.volume.mantissa(), std::memory_order_relaxed);
+        volumeExponent.store(level.volume.exponent(), std::memory_order_relaxed);
+        orderCount.store(level.orderCount, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] DepthLevel load() const {
+        return {
+            Price::fromParts(priceMantissa.load(std::memory_order_relaxed),
+                             priceExponent.load(std::memory_order_relaxed)),
+            Quantity::fromParts(volumeMantissa.load(std::memory_order_relaxed),
+                                volumeExponent.load(std::memory_order_relaxed)),
+            orderCount.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+/**
+ * Sorted side of the book, the best level is at the back
+ * @tparam Worse orders a worse price before a better one, std::less for bids and std::greater for asks
+ */
+template<typename Worse>
+struct BookSide {
+    std::vector<DepthLevel> levels;
+
+    void update(const DepthLevel &level) {
+        const auto it = std::ranges::lower_bound(levels, level.price, Worse{}, &DepthLevel::price);
+
+        if (it != levels.end() && it->price == level.price) {
+            if (level.volume.isZero()) {
+                levels.erase(it);
+            } else {
+                *it = level;
+            }
+        } else if (!level.volume.isZero()) {
+            levels.insert(it, level);
+        }
+    }
+
+    void assign(const std::vector<DepthLevel> &snapshot) {
+        levels.clear();
+        std::ranges::copy_if(snapshot, std::back_inserter(levels), [](const DepthLevel &level) {
+            return !level.volume.isZero();
+        });
+        std::ranges::sort(levels, Worse{}, &DepthLevel::price);
+    }
+
+    void publish(PublishedLevel *published, const std::size_t count) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            published[i].store(levels[levels.size() - 1 - i]);
+        }
+    }
+};
+}
+
+struct OrderBook::P {
+    /// Serializes the IO thread applying updates and the thread applying snapshots
+    std::mutex writeMutex;
+    BookSide<std::less<>> bids;
+    BookSide<std::greater<>> asks;
+    std::int64_t version{};
+    std::int64_t ts{};
+    bool isSynced{false};
+    std::deque<EventDepth> buffered;
+
+    /// Odd while the published state is being written
+    alignas(64) std::atomic<std::uint64_t> sequence{0};
+    const std::size_t publishedLevels;
+    std::unique_ptr<PublishedLevel[]> publishedBids;
+    std::unique_ptr<PublishedLevel[]> publishedAsks;
+    std::atomic<std::size_t> publishedBidCount{0};
+    std::atomic<std::size_t> publishedAskCount{0};
+    std::atomic<std::int64_t> publishedVersion{0};
+    std::atomic<std::int64_t> publishedTs{0};
+    std::atomic<bool> publishedIsSynced{false};
+
+    explicit P(const std::size_t publishedLevels) : publishedLevels(std::max<std::size_t>(publishedLevels, 1)),
+                                                    publishedBids(std::make_unique<PublishedLevel[]>(
+                                                        this->publishedLevels)),
+                                                    publishedAsks(std::make_unique<PublishedLevel[]>(
+                                                        this->publishedLevels)) {
+    }
+
+    void applyLevels(const EventDepth &update) {
+        for (const auto &level: update.bids) {
+            bids.update(level);
+        }
+
+        for (const auto &level: update.asks) {
+            asks.update(level);
+        }
+
+        version = update.version;
+        ts = update.ts;
+    }
+
+    void buffer(const EventDepth &update) {
+        if (buffered.size() >= MAX_BUFFERED_UPDATES) {
+            buffered.pop_front();
+        }
+
+        buffered.push_back(update);
+    }
+
+    /// Must be called with writeMutex locked
+    void publish() {
+        const auto start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const auto bidCount = std::min(bids.levels.size(), publishedLevels);
+        const auto askCount = std::min(asks.levels.size(), publishedLevels);
+        bids.publish(publishedBids.get(), bidCount);
+        asks.publish(publishedAsks.get(), askCount);
+        publishedBidCount.store(bidCount, std::memory_order_relaxed);
+        publishedAskCount.store(askCount, std::memory_order_relaxed);
+        publishedVersion.store(version, std::memory_order_relaxed);
+        publishedTs.store(ts, std::memory_order_relaxed);
+        publishedIsSynced.store(isSynced, std::memory_order_relaxed);
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    /**
+     * Read the published state consistently, retried while a write overlaps
+     * @param read reads the published fields, called again after a retry
+     */
+    template<typename Read>
+    auto readPublished(Read read) const {
+        for (;;) {
+            const auto start = sequence.load(std::memory_order_acquire);
+
+            if (start & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            auto retVal = read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == start) {
+                return retVal;
+            }
+        }
+    }
+};
+
+OrderBook::OrderBook(const std::size_t publishedLevels) : m_p(std::make_unique<P>(publishedLevels)) {
+}
+
+OrderBook::~OrderBook() = default;
+
+BookUpdate OrderBook::apply(const EventDepth &update) const {
+    std::lock_guard lock(m_p->writeMutex);
+
+    if (!m_p->isSynced) {
+        m_p->buffer(update);
+        return BookUpdate::Buffered;
+    }
+
+    if (update.version <= m_p->version) {
+        return BookUpdate::Applied;
+    }
+
+    if (update.version != m_p->version + 1) {
+        m_p->isSynced = false;
+        m_p->buffer(update);
+        m_p->publish();
+        return BookUpdate::Gap;
+    }
+
+    m_p->applyLevels(update);
+    m_p->publish();
+    return BookUpdate::Applied;
+}
+
+bool OrderBook::applySnapshot(const EventDepth &snapshot) const {
+    std::lock_guard lock(m_p->writeMutex);
+    m_p->bids.assign(snapshot.bids);
+    m_p->asks.assign(snapshot.asks);
+    m_p->version = snapshot.version;
+    m_p->ts = snapshot.ts;
+    m_p->isSynced = true;
+
+    while (!m_p->buffered.empty()) {
+        const auto &update = m_p->buffered.front();
+
+        if (update.version > m_p->version + 1) {
+            /// The snapshot is older than the buffered updates, keep them for the next one
+            m_p->isSynced = false;
+            break;
+        }
+
+        if (update.version == m_p->version + 1) {
+            m_p->applyLevels(update);
+        }
+
+        m_p->buffered.pop_front();
+    }
+
+    m_p->publish();
+    return m_p->isSynced;
+}
+
+void OrderBook::invalidate() const {
+    std::lock_guard lock(m_p->writeMutex);
+    m_p->isSynced = false;
+    m_p->buffered.clear();
+    m_p->publish();
+}
+
+bool OrderBook::isSynced() const {
+    return m_p->readPublished([&] {
+        return m_p->publishedIsSynced.load(std::memory_order_relaxed);
+    });
+}
+
+std::optional<BookTop> OrderBook::top() const {
+    return m_p->readPublished([&]() -> std::optional<BookTop> {
+        if (!m_p->publishedIsSynced.load(std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+
+        BookTop retVal;
+
+        if (m_p->publishedBidCount.load(std::memory_order_relaxed) > 0) {
+            retVal.bid = m_p->publishedBids[0].load();
+        }
+
+        if (m_p->publishedAskCount.load(std::memory_order_relaxed) > 0) {
+            retVal.ask = m_p->publishedAsks[0].load();
+        }
+
+        retVal.version = m_p->publishedVersion.load(std::memory_order_relaxed);
+        retVal.ts = m_p->publishedTs.load(std::memory_order_relaxed);
+        return retVal;
+    });
+}
+
+std::optional<BookDepth> OrderBook::depth(const std::size_t levels) const {
+    std::optional<BookDepth> retVal = BookDepth{};
+    retVal->bids.reserve(std::min(levels, m_p->publishedLevels));
+    retVal->asks.reserve(std::min(levels, m_p->publishedLevels));
+
+    const auto isSynced = m_p->readPublished([&] {
+        if (!m_p->publishedIsSynced.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const auto bidCount = std::min(levels, m_p->publishedBidCount.load(std::memory_order_relaxed));
+        const auto askCount = std::min(levels, m_p->publishedAskCount.load(std::memory_order_relaxed));
+        retVal->bids.clear();
+        retVal->asks.clear();
+
+        for (std::size_t i = 0; i < bidCount; ++i) {
+            retVal->bids.push_back(m_p->publishedBids[i].load());
+        }
+
+        for (std::size_t i = 0; i < askCount; ++i) {
+            retVal->asks.push_back(m_p->publishedAsks[i].load());
+        }
+
+        retVal->version = m_p->publishedVersion.load(std::memory_order_relaxed);
+        retVal->ts = m_p->publishedTs.load(std::memory_order_relaxed);
+        return true;
+    });
+
+    if (!isSynced) {
+        return std::nullopt;
+    }
+
+    return retVal;
+}
+
+std::size_t OrderBook::publishedLevels() const {
+    return m_p->publishedLevels;
+}
+}
@@ -0,0 +1,72 @@
+/**
+MEXC Request Coalescer
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_request_coalescer.h"
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+namespace vk::mexc {
+struct RequestCoalescer::P {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_future<Response>> inFlight;
+    std::atomic<std::int64_t> coalesced{0};
+};
+
+RequestCoalescer::RequestCoalescer() : m_p(std::make_unique<P>()) {
+}
+
+RequestCoalescer::~RequestCoalescer() = default;
+
+std::string RequestCoalescer::makeKey(const std::string &path, const std::map<std::string, std::string> &parameters) {
+    std::string key = path;
+
+    for (const auto &[fst, snd]: parameters) {
+        key.append("|");
+        key.append(fst);
+        key.append("=");
+        key.append(snd);
+    }
+
+    return key;
+}
+
+RequestCoalescer::Response RequestCoalescer::run(const std::string &key, const std::function<Response()> &request) const {
+    std::unique_lock lock(m_p->mutex);
+
+    if (const auto it = m_p->inFlight.find(key); it != m_p->inFlight.end()) {
+        /// Identical request is already on the wire, wait for its result
+        const auto pending = it->second;
+        lock.unlock();
+        ++m_p->coalesced;
+        return pending.get();
+    }
+
+    std::promise<Response> promise;
+    m_p->inFlight.insert_or_assign(key, promise.get_future().share());
+    lock.unlock();
+
+    try {
+        auto response = request();
+        promise.set_value(response);
+        lock.lock();
+        m_p->inFlight.erase(key);
+        return response;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        lock.lock();
+        m_p->inFlight.erase(key);
+        throw;
+    }
+}
+
+std::int64_t RequestCoalescer::coalescedCount() const {
+    return m_p->coalesced;
+}
+}
@@ -0,0 +1,198 @@
+/**
+MEXC Retry Policy
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_retry_policy.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace vk::mexc {
+namespace http = boost::beast::http;
+
+struct RetryPolicy::P {
+    enum class CircuitState {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    struct Circuit {
+        CircuitState state{CircuitState::Closed};
+        int consecutiveFailures{};
+        std::chrono::steady_clock::time_point openUntil{};
+    };
+
+    mutable std::mutex mutex;
+    RetrySettings settings;
+    std::unordered_map<std::string, Circuit> circuits;
+    std::atomic<std::int64_t> requests{0};
+    std::atomic<std::int64_t> retries{0};
+    std::atomic<std::int64_t> failures{0};
+    std::atomic<std::int64_t> rejected{0};
+    std::atomic<std::int64_t> circuitOpenings{0};
+
+    static bool isRetryable(const Response &response) {
+        return response.result() == http::status::too_many_requests ||
+               http::to_status_class(response.result()) == http::status_class::server_error;
+    }
+
+    /// Full jitter, uniformly distributed in [0, min(maxBackoff, initialBackoff * multiplier^attempt)]
+    static std::chrono::milliseconds backoff(const RetrySettings &settings, const int attempt) {
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        const auto ceiling = std::min(static_cast<double>(settings.maxBackoff.count()),
+                                      static_cast<double>(settings.initialBackoff.count()) *
+                                      std::pow(settings.backoffMultiplier, attempt));
+        std::uniform_int_distribution<std::int64_t> distribution(0, static_cast<std::int64_t>(ceiling));
+        return std::chrono::milliseconds(distribution(generator));
+    }
+
+    /// @return false if the request must fail fast
+    bool acquire(const std::string &endpoint) {
+        std::lock_guard lk(mutex);
+        auto &circuit = circuits[endpoint];
+
+        switch (circuit.state) {
+        case CircuitState::Closed:
+            return true;
+        case CircuitState::Open:
+            if (std::chrono::steady_clock::now() < circuit.openUntil) {
+                return false;
+            }
+            circuit.state = CircuitState::HalfOpen;
+            return true;
+        case CircuitState::HalfOpen:
+            /// Trial request is in flight
+            return false;
+        }
+
+        return true;
+    }
+
+    void onSuccess(const std::string &endpoint) {
+        std::lock_guard lk(mutex);
+        auto &circuit = circuits[endpoint];
+        circuit.state = CircuitState::Closed;
+        circuit.consecutiveFailures = 0;
+    }
+
+    /// @return true if the circuit is open, the request must not be retried
+    bool onFailure(const std::string &endpoint) {
+        std::lock_guard lk(mutex);
+        auto &circuit = circuits[endpoint];
+        ++circuit.consecutiveFailures;
+
+        if (circuit.state == CircuitState::HalfOpen || circuit.consecutiveFailures >= settings.failureThreshold) {
+            if (circuit.state != CircuitState::Open) {
+                ++circuitOpenings;
+            }
+            circuit.state = CircuitState::Open;
+            circuit.openUntil = std::chrono::steady_clock::now() + settings.openDuration;
+        }
+
+        return circuit.state == CircuitState::Open;
+    }
+};
+
+RetryPolicy::RetryPolicy() : m_p(std::make_unique<P>()) {
+}
+
+RetryPolicy::~RetryPolicy() = default;
+
+void RetryPolicy::setSettings(const RetrySettings &settings) const {
+    std::lock_guard lk(m_p->mutex);
+    m_p->settings = settings;
+}
+
+RetrySettings RetryPolicy::settings() const {
+    std::lock_guard lk(m_p->mutex);
+    return m_p->settings;
+}
+
+RetryPolicy::Response RetryPolicy::run(const std::string &endpoint, const std::function<Response()> &request) const {
+    const auto currentSettings = settings();
+    ++m_p->requests;
+    /// Outcome of the previous attempt, reported when the circuit opens before the next one
+    Response lastResponse;
+    std::exception_ptr lastError;
+
+    for (int attempt = 0;; ++attempt) {
+        if (!m_p->acquire(endpoint)) {
+            if (attempt == 0) {
+                ++m_p->rejected;
+                throw std::runtime_error(fmt::format("Circuit open, request to {} rejected", endpoint));
+            }
+
+            /// Another request opened the circuit during the backoff, this one fails with its own error
+            ++m_p->failures;
+
+            if (lastError) {
+                std::rethrow_exception(lastError);
+            }
+
+            return lastResponse;
+        }
+
+        const bool isLastAttempt = attempt + 1 >= currentSettings.maxAttempts;
+
+        try {
+            auto response = request();
+
+            if (!P::isRetryable(response)) {
+                m_p->onSuccess(endpoint);
+                return response;
+            }
+
+            if (m_p->onFailure(endpoint) || isLastAttempt) {
+                ++m_p->failures;
+                return response;
+            }
+
+            lastResponse = std::move(response);
+            lastError = nullptr;
+        } catch (...) {
+            if (m_p->onFailure(endpoint) || isLastAttempt) {
+                ++m_p->failures;
+                throw;
+            }
+
+            lastError = std::current_exception();
+        }
+
+        ++m_p->retries;
+        std::this_thread::sleep_for(P::backoff(currentSettings, attempt));
+    }
+}
+
+bool RetryPolicy::isCircuitOpen(const std::string &endpoint) const {
+    std::lock_guard lk(m_p->mutex);
+    const auto it = m_p->circuits.find(endpoint);
+    return it != m_p->circuits.end() && it->second.state != P::CircuitState::Closed;
+}
+
+RetryStats RetryPolicy::stats() const {
+    RetryStats retVal;
+    retVal.requests = m_p->requests;
+    retVal.retries = m_p->retries;
+    retVal.failures = m_p->failures;
+    retVal.rejected = m_p->rejected;
+    retVal.circuitOpenings = m_p->circuitOpenings;
+
+    std::lock_guard lk(m_p->mutex);
+    retVal.openCircuits = std::count_if(m_p->circuits.begin(), m_p->circuits.end(), [](const auto &circuit) {
+        return circuit.second.state != P::CircuitState::Closed;
+    });
+
+    return retVal;
+}
+}
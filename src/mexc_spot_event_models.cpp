@@ -0,0 +1,360 @@
+/**
+MEXC Spot Event Data Models
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_spot_event_models.h"
+#include "vk/mexc/mexc_protobuf_reader.h"
+#include <charconv>
+
+namespace vk::mexc::spot {
+namespace {
+/// PushDataV3ApiWrapper field numbers
+constexpr std::uint32_t WRAPPER_CHANNEL = 1;
+constexpr std::uint32_t WRAPPER_SYMBOL = 3;
+constexpr std::uint32_t WRAPPER_SEND_TIME = 6;
+constexpr std::uint32_t WRAPPER_PUBLIC_LIMIT_DEPTHS = 303;
+constexpr std::uint32_t WRAPPER_PRIVATE_ORDERS = 304;
+constexpr std::uint32_t WRAPPER_PRIVATE_DEALS = 306;
+constexpr std::uint32_t WRAPPER_PRIVATE_ACCOUNT = 307;
+constexpr std::uint32_t WRAPPER_PUBLIC_SPOT_KLINE = 308;
+constexpr std::uint32_t WRAPPER_PUBLIC_AGGRE_DEPTHS = 313;
+constexpr std::uint32_t WRAPPER_PUBLIC_AGGRE_DEALS = 314;
+
+/// MEXC sends all decimal values as strings
+double toDouble(const std::string_view value) {
+    double retVal = 0.0;
+    std::from_chars(value.data(), value.data() + value.size(), retVal);
+    return retVal;
+}
+
+std::int64_t toInt64(const std::string_view value) {
+    std::int64_t retVal = 0;
+    std::from_chars(value.data(), value.data() + value.size(), retVal);
+    return retVal;
+}
+
+PriceLevel readPriceLevel(const std::string_view buffer) {
+    PriceLevel retVal;
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            retVal.price = toDouble(reader.readBytes());
+            break;
+        case 2:
+            retVal.quantity = toDouble(reader.readBytes());
+            break;
+        default:
+            reader.skip();
+        }
+    }
+
+    return retVal;
+}
+}
+
+void EventDeals::fromProtobuf(const std::string_view buffer) {
+    deals.clear();
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        if (reader.fieldNumber() != 1) {
+            reader.skip();
+            continue;
+        }
+
+        Deal deal;
+        ProtobufReader item(reader.readBytes());
+
+        while (item.next()) {
+            switch (item.fieldNumber()) {
+            case 1:
+                deal.price = toDouble(item.readBytes());
+                break;
+            case 2:
+                deal.quantity = toDouble(item.readBytes());
+                break;
+            case 3:
+                deal.tradeType = item.readInt32();
+                break;
+            case 4:
+                deal.time = item.readInt64();
+                break;
+            default:
+                item.skip();
+            }
+        }
+
+        deals.push_back(deal);
+    }
+}
+
+void EventDepth::fromProtobuf(const std::string_view buffer, const bool snapshot) {
+    isSnapshot = snapshot;
+    asks.clear();
+    bids.clear();
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            asks.push_back(readPriceLevel(reader.readBytes()));
+            break;
+        case 2:
+            bids.push_back(readPriceLevel(reader.readBytes()));
+            break;
+        case 4:
+            /// fromVersion for incremental depth, version for the limited depth snapshot
+            fromVersion = toInt64(reader.readBytes());
+            if (snapshot) {
+                toVersion = fromVersion;
+            }
+            break;
+        case 5:
+            toVersion = toInt64(reader.readBytes());
+            break;
+        default:
+            reader.skip();
+        }
+    }
+}
+
+void EventCandlestick::fromProtobuf(const std::string_view buffer) {
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            if (const auto value = magic_enum::enum_cast<CandleInterval>(reader.readBytes())) {
+                interval = *value;
+            }
+            break;
+        case 2:
+            windowStart = reader.readInt64();
+            break;
+        case 3:
+            open = toDouble(reader.readBytes());
+            break;
+        case 4:
+            close = toDouble(reader.readBytes());
+            break;
+        case 5:
+            high = toDouble(reader.readBytes());
+            break;
+        case 6:
+            low = toDouble(reader.readBytes());
+            break;
+        case 7:
+            volume = toDouble(reader.readBytes());
+            break;
+        case 8:
+            amount = toDouble(reader.readBytes());
+            break;
+        case 9:
+            windowEnd = reader.readInt64();
+            break;
+        default:
+            reader.skip();
+        }
+    }
+}
+
+void EventOrder::fromProtobuf(const std::string_view buffer) {
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            orderId = reader.readBytes();
+            break;
+        case 2:
+            clientOrderId = reader.readBytes();
+            break;
+        case 3:
+            price = toDouble(reader.readBytes());
+            break;
+        case 4:
+            quantity = toDouble(reader.readBytes());
+            break;
+        case 5:
+            amount = toDouble(reader.readBytes());
+            break;
+        case 6:
+            avgPrice = toDouble(reader.readBytes());
+            break;
+        case 7:
+            orderType = reader.readInt32();
+            break;
+        case 8:
+            tradeType = reader.readInt32();
+            break;
+        case 9:
+            isMaker = reader.readBool();
+            break;
+        case 10:
+            remainAmount = toDouble(reader.readBytes());
+            break;
+        case 11:
+            remainQuantity = toDouble(reader.readBytes());
+            break;
+        case 13:
+            cumulativeQuantity = toDouble(reader.readBytes());
+            break;
+        case 14:
+            cumulativeAmount = toDouble(reader.readBytes());
+            break;
+        case 15:
+            status = reader.readInt32();
+            break;
+        case 16:
+            createTime = reader.readInt64();
+            break;
+        default:
+            reader.skip();
+        }
+    }
+}
+
+void EventFill::fromProtobuf(const std::string_view buffer) {
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            price = toDouble(reader.readBytes());
+            break;
+        case 2:
+            quantity = toDouble(reader.readBytes());
+            break;
+        case 3:
+            amount = toDouble(reader.readBytes());
+            break;
+        case 4:
+            tradeType = reader.readInt32();
+            break;
+        case 5:
+            isMaker = reader.readBool();
+            break;
+        case 6:
+            isSelfTrade = reader.readBool();
+            break;
+        case 7:
+            tradeId = reader.readBytes();
+            break;
+        case 8:
+            clientOrderId = reader.readBytes();
+            break;
+        case 9:
+            orderId = reader.readBytes();
+            break;
+        case 10:
+            feeAmount = toDouble(reader.readBytes());
+            break;
+        case 11:
+            feeCurrency = reader.readBytes();
+            break;
+        case 12:
+            time = reader.readInt64();
+            break;
+        default:
+            reader.skip();
+        }
+    }
+}
+
+void EventBalance::fromProtobuf(const std::string_view buffer) {
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case 1:
+            asset = reader.readBytes();
+            break;
+        case 3:
+            balance = toDouble(reader.readBytes());
+            break;
+        case 4:
+            balanceChange = toDouble(reader.readBytes());
+            break;
+        case 5:
+            frozen = toDouble(reader.readBytes());
+            break;
+        case 6:
+            frozenChange = toDouble(reader.readBytes());
+            break;
+        case 7:
+            changeType = reader.readBytes();
+            break;
+        case 8:
+            time = reader.readInt64();
+            break;
+        default:
+            reader.skip();
+        }
+    }
+}
+
+void Event::fromProtobuf(const std::string_view buffer) {
+    data = std::monostate{};
+    ProtobufReader reader(buffer);
+
+    while (reader.next()) {
+        switch (reader.fieldNumber()) {
+        case WRAPPER_CHANNEL:
+            channel = reader.readBytes();
+            break;
+        case WRAPPER_SYMBOL:
+            symbol = reader.readBytes();
+            break;
+        case WRAPPER_SEND_TIME:
+            sendTime = reader.readInt64();
+            break;
+        case WRAPPER_PUBLIC_AGGRE_DEALS: {
+            EventDeals deals;
+            deals.fromProtobuf(reader.readBytes());
+            data = std::move(deals);
+            break;
+        }
+        case WRAPPER_PUBLIC_AGGRE_DEPTHS:
+        case WRAPPER_PUBLIC_LIMIT_DEPTHS: {
+            const bool snapshot = reader.fieldNumber() == WRAPPER_PUBLIC_LIMIT_DEPTHS;
+            EventDepth depth;
+            depth.fromProtobuf(reader.readBytes(), snapshot);
+            data = std::move(depth);
+            break;
+        }
+        case WRAPPER_PUBLIC_SPOT_KLINE: {
+            EventCandlestick candlestick;
+            candlestick.fromProtobuf(reader.readBytes());
+            data = candlestick;
+            break;
+        }
+        case WRAPPER_PRIVATE_ORDERS: {
+            EventOrder order;
+            order.fromProtobuf(reader.readBytes());
+            data = std::move(order);
+            break;
+        }
+        case WRAPPER_PRIVATE_DEALS: {
+            EventFill fill;
+            fill.fromProtobuf(reader.readBytes());
+            data = std::move(fill);
+            break;
+        }
+        case WRAPPER_PRIVATE_ACCOUNT: {
+            EventBalance balance;
+            balance.fromProtobuf(reader.readBytes());
+            data = std::move(balance);
+            break;
+        }
+        default:
+            reader.skip();
+        }
+    }
+}
+}
@@ -15,6 +15,8 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include <mutex>
 
 #include "vk/mexc/mexc_http_spot_session.h"
+#include "vk/mexc/mexc_request_coalescer.h"
+#include "vk/mexc/mexc_retry_policy.h"
 #include <deque>
 #include <thread>
 #include <chrono>
@@ -75,11 +77,21 @@ public:
     RESTClient *parent = nullptr;
     std::shared_ptr<HTTPSession> httpSession;
     mutable RateLimiter rateLimiter;
+    RequestCoalescer coalescer;
+    RetryPolicy retryPolicy;
+    std::shared_ptr<ClockSync> clockSync = std::make_shared<ClockSync>();
+    int receiveWindow = 25000;
 
     explicit P(RESTClient *parent) {
         this->parent = parent;
     }
 
+    void createSession(const std::string &apiKey, const std::string &apiSecret) {
+        httpSession = std::make_shared<HTTPSession>(apiKey, apiSecret);
+        httpSession->setClockSync(clockSync);
+        httpSession->setReceiveWindow(receiveWindow);
+    }
+
     static http::response<http::string_body> checkResponse(const http::response<http::string_body> &response) {
         if (response.result() != http::status::ok) {
             throw std::runtime_error(
@@ -88,6 +100,18 @@ public:
         return response;
     }
 
+    /// Public GET request, identical concurrent requests are coalesced into one, failures are retried by the policy
+    [[nodiscard]] http::response<http::string_body> publicGet(const std::string &path,
+                                                              const std::map<std::string, std::string> &parameters) const {
+        return coalescer.run(RequestCoalescer::makeKey(path, parameters), [&] {
+            return checkResponse(retryPolicy.run(path, [&] {
+                auto requestParameters = parameters;
+                rateLimiter.wait();
+                return httpSession->methodGet(path, requestParameters);
+            }));
+        });
+    }
+
     [[nodiscard]] std::vector<Candle>
     getHistoricalPrices(const std::string &symbol, const CandleInterval interval, const std::int64_t startTime,
                         const std::int64_t endTime, const std::int32_t limit) const {
@@ -108,8 +132,7 @@ public:
             parameters.insert_or_assign("limit", std::to_string(limit));
         }
 
-        rateLimiter.wait();
-        const auto response = checkResponse(httpSession->methodGet(path, parameters));
+        const auto response = publicGet(path, parameters);
 
         for (const auto responseJson = nlohmann::json::parse(response.body()); const auto &el: responseJson) {
             Candle candle;
@@ -123,14 +146,14 @@ public:
 
 RESTClient::RESTClient(const std::string &apiKey, const std::string &apiSecret) : m_p(
     std::make_unique<P>(this)) {
-    m_p->httpSession = std::make_shared<HTTPSession>(apiKey, apiSecret);
+    m_p->createSession(apiKey, apiSecret);
 }
 
 RESTClient::~RESTClient() = default;
 
 void RESTClient::setCredentials(const std::string &apiKey, const std::string &apiSecret) const {
     m_p->httpSession.reset();
-    m_p->httpSession = std::make_shared<HTTPSession>(apiKey, apiSecret);
+    m_p->createSession(apiKey, apiSecret);
 }
 
 std::vector<Candle> RESTClient::getHistoricalPrices(const std::string &symbol, const CandleInterval interval,
@@ -210,14 +233,38 @@ std::int64_t RESTClient::getServerTime() const {
     return retVal.serverTime;
 }
 
+std::int64_t RESTClient::synchronizeClock(const int samples) const {
+    const std::string path = "/api/v3/time";
+
+    for (int i = 0; i < samples; ++i) {
+        std::int64_t requestTime = 0;
+        std::int64_t responseTime = 0;
+        m_p->rateLimiter.wait();
+        const auto response = P::checkResponse(m_p->httpSession->methodGetTimed(path, requestTime, responseTime));
+        ServerTime serverTime;
+        serverTime.fromJson(nlohmann::json::parse(response.body()));
+        m_p->clockSync->addSample(requestTime, serverTime.serverTime, responseTime);
+    }
+
+    return m_p->clockSync->offset();
+}
+
+const ClockSync &RESTClient::clockSync() const {
+    return *m_p->clockSync;
+}
+
+void RESTClient::setReceiveWindow(const int receiveWindow) const {
+    m_p->receiveWindow = receiveWindow;
+    m_p->httpSession->setReceiveWindow(receiveWindow);
+}
+
 std::vector<TickerPrice> RESTClient::getTickerPrice(const std::string &symbol) const {
     std::vector<TickerPrice> retVal;
     const std::string path = "/api/v3/ticker/price";
     std::map<std::string, std::string> parameters;
     parameters.insert_or_assign("symbol", symbol);
 
-    m_p->rateLimiter.wait();
-    const auto response = P::checkResponse(m_p->httpSession->methodGet(path, parameters));
+    const auto response = m_p->publicGet(path, parameters);
 
     if (const auto responseJson = nlohmann::json::parse(response.body());
         responseJson.type() == nlohmann::json::object()) {
@@ -235,6 +282,37 @@ std::vector<TickerPrice> RESTClient::getTickerPrice(const std::string &symbol) c
     return retVal;
 }
 
+TickerPriceSnapshot RESTClient::getTickerPriceSnapshot() const {
+    const std::string path = "/api/v3/ticker/price";
+    const auto response = m_p->publicGet(path, {});
+
+    const auto json = nlohmann::json::parse(response.body());
+
+    /// An error object would give an empty snapshot, the diff against it would report every symbol as removed
+    if (!json.is_array()) {
+        TickerPriceSnapshot error;
+        error.fromJson(json);
+        throw std::runtime_error(
+            fmt::format("MEXC API error, code: {}, msg: {}", error.code, error.msg).c_str());
+    }
+
+    TickerPriceSnapshot retVal;
+    retVal.fromJson(json);
+    return retVal;
+}
+
+std::int64_t RESTClient::coalescedRequestsCount() const {
+    return m_p->coalescer.coalescedCount();
+}
+
+void RESTClient::setRetrySettings(const RetrySettings &settings) const {
+    m_p->retryPolicy.setSettings(settings);
+}
+
+RetryStats RESTClient::retryStats() const {
+    return m_p->retryPolicy.stats();
+}
+
 std::string RESTClient::getListenKey() const {
     const std::string path = "/api/v3/userDataStream";
     std::map<std::string, std::string> parameters;
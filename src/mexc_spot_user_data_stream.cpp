@@ -0,0 +1,248 @@
+/**
+MEXC Spot User Data Stream
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_spot_user_data_stream.h"
+#include "vk/mexc/mexc_spot_rest_client.h"
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <fmt/format.h>
+#include <mutex>
+
+namespace vk::mexc::spot {
+static auto MEXC_SPOT_WS_HOST = "wbs-api.mexc.com";
+static auto MEXC_SPOT_WS_PORT = "443";
+
+/// The listen key expires 60 minutes after creation or the last renewal
+static constexpr auto LISTEN_KEY_RENEW_INTERVAL = std::chrono::minutes(30);
+static constexpr auto RECONNECT_DELAY = std::chrono::seconds(5);
+
+static const std::vector<std::string> PRIVATE_CHANNELS = {
+    "spot@private.orders.v3.api.pb",
+    "spot@private.deals.v3.api.pb",
+    "spot@private.account.v3.api.pb"
+};
+
+struct UserDataStream::P : std::enable_shared_from_this<P> {
+    boost::asio::io_context &ioc;
+    boost::asio::ssl::context ctx;
+    boost::asio::strand<boost::asio::io_context::executor_type> strand;
+    boost::asio::steady_timer renewTimer;
+    boost::asio::steady_timer reconnectTimer;
+    /// Listen key REST calls are blocking, they run here to keep the shared IO context responsive
+    boost::asio::thread_pool restPool{1};
+    RESTClient restClient;
+    std::shared_ptr<WebSocketSession> session;
+    std::string listenKey;
+    std::atomic<bool> isRunning{false};
+    mutable std::mutex locker;
+    onLogMessage logMessageCB;
+    onDataEvent dataEventCB;
+
+    P(boost::asio::io_context &ioc, const std::string &apiKey, const std::string &apiSecret) :
+        ioc(ioc), ctx(boost::asio::ssl::context::sslv23_client), strand(make_strand(ioc)), renewTimer(strand),
+        reconnectTimer(strand), restClient(apiKey, apiSecret), logMessageCB(defaultLogFunction) {
+    }
+
+    /// Run handler on the stream strand, only while the stream exists
+    template<typename Handler>
+    void dispatchToStrand(Handler &&handler) {
+        boost::asio::post(strand, [weak = weak_from_this(), handler = std::forward<Handler>(handler)] {
+            if (const auto self = weak.lock()) {
+                handler(*self);
+            }
+        });
+    }
+
+    void connect() {
+        if (!isRunning) {
+            return;
+        }
+
+        boost::asio::post(restPool, [weak = weak_from_this()] {
+            const auto self = weak.lock();
+
+            if (!self) {
+                return;
+            }
+
+            try {
+                auto key = self->restClient.getListenKey();
+                self->dispatchToStrand([key = std::move(key)](P &p) { p.openSession(key); });
+            } catch (std::exception &e) {
+                self->logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+                self->dispatchToStrand([](P &p) { p.scheduleReconnect(); });
+            }
+        });
+    }
+
+    void openSession(const std::string &key) {
+        if (!isRunning) {
+            return;
+        }
+
+        const auto ws = std::make_shared<WebSocketSession>(ioc, ctx, logMessageCB);
+        ws->setSessionClosedCallback([weak = weak_from_this()] {
+            if (const auto self = weak.lock()) {
+                self->dispatchToStrand([](P &p) { p.onSessionClosed(); });
+            }
+        });
+
+        {
+            std::lock_guard lk(locker);
+            listenKey = key;
+            session = ws;
+        }
+
+        ws->run(MEXC_SPOT_WS_HOST, MEXC_SPOT_WS_PORT, "/ws?listenKey=" + key, PRIVATE_CHANNELS, dataEventCB);
+        scheduleRenew();
+    }
+
+    void scheduleRenew() {
+        renewTimer.expires_after(LISTEN_KEY_RENEW_INTERVAL);
+        renewTimer.async_wait([weak = weak_from_this()](const boost::system::error_code &ec) {
+            if (const auto self = weak.lock(); self && !ec) {
+                self->renew();
+            }
+        });
+    }
+
+    void renew() {
+        boost::asio::post(restPool, [weak = weak_from_this()] {
+            const auto self = weak.lock();
+
+            if (!self) {
+                return;
+            }
+
+            std::string key;
+
+            {
+                std::lock_guard lk(self->locker);
+                key = self->listenKey;
+            }
+
+            try {
+                static_cast<void>(self->restClient.renewListenKey(key));
+                self->dispatchToStrand([](P &p) { p.scheduleRenew(); });
+            } catch (std::exception &e) {
+                /// Key has probably expired, the closed session reconnects with a new one
+                self->logMessageCB(LogSeverity::Warning, fmt::format("{}: listen key renewal failed: {}", MAKE_FILELINE, e.what()));
+                self->dispatchToStrand([](P &p) { p.closeSession(); });
+            }
+        });
+    }
+
+    void closeSession() {
+        std::lock_guard lk(locker);
+
+        if (session) {
+            session->close();
+        }
+    }
+
+    void onSessionClosed() {
+        renewTimer.cancel();
+
+        std::string key;
+
+        {
+            std::lock_guard lk(locker);
+            session.reset();
+            key = std::move(listenKey);
+            listenKey.clear();
+        }
+
+        closeListenKey(key);
+
+        if (isRunning) {
+            logMessageCB(LogSeverity::Warning, "User data stream disconnected, reconnecting with a new listen key");
+            scheduleReconnect();
+        }
+    }
+
+    void scheduleReconnect() {
+        reconnectTimer.expires_after(RECONNECT_DELAY);
+        reconnectTimer.async_wait([weak = weak_from_this()](const boost::system::error_code &ec) {
+            if (const auto self = weak.lock(); self && !ec) {
+                self->connect();
+            }
+        });
+    }
+
+    void closeListenKey(const std::string &key) {
+        if (key.empty()) {
+            return;
+        }
+
+        boost::asio::post(restPool, [weak = weak_from_this(), key] {
+            if (const auto self = weak.lock()) {
+                try {
+                    static_cast<void>(self->restClient.closeListenKey(key));
+                } catch (std::exception &e) {
+                    self->logMessageCB(LogSeverity::Warning, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+                }
+            }
+        });
+    }
+};
+
+UserDataStream::UserDataStream(boost::asio::io_context &ioc, const std::string &apiKey, const std::string &apiSecret) :
+    m_p(std::make_shared<P>(ioc, apiKey, apiSecret)) {
+}
+
+UserDataStream::~UserDataStream() {
+    stop();
+    m_p->restPool.join();
+}
+
+void UserDataStream::setLoggerCallback(const onLogMessage &onLogMessageCB) const {
+    m_p->logMessageCB = onLogMessageCB;
+}
+
+void UserDataStream::setDataEventCallback(const onDataEvent &onDataEventCB) const {
+    m_p->dataEventCB = onDataEventCB;
+}
+
+void UserDataStream::start() const {
+    if (m_p->isRunning.exchange(true)) {
+        return;
+    }
+
+    m_p->connect();
+}
+
+void UserDataStream::stop() const {
+    if (!m_p->isRunning.exchange(false)) {
+        return;
+    }
+
+    std::string key;
+
+    {
+        std::lock_guard lk(m_p->locker);
+
+        if (m_p->session) {
+            m_p->session->close();
+            m_p->session.reset();
+        }
+
+        key = std::move(m_p->listenKey);
+        m_p->listenKey.clear();
+    }
+
+    m_p->dispatchToStrand([](P &p) {
+        p.renewTimer.cancel();
+        p.reconnectTimer.cancel();
+    });
+
+    m_p->closeListenKey(key);
+}
+}
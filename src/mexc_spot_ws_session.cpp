@@ -0,0 +1,425 @@
+/**
+MEXC Spot WebSocket Session
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_spot_ws_session.h"
+#include "vk/utils/log_utils.h"
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+
+namespace vk::mexc::spot {
+/// Server closes the connection when no PING arrives for 60 s
+static constexpr int PING_INTERVAL_IN_S = 20;
+
+/// Server refuses the subscriptions beyond it
+static constexpr std::size_t MAX_CHANNELS_PER_CONNECTION = 30;
+
+/**
+ * Channels named by a control message, e.g. "spot@public.deals.v3.api.pb@100ms@BTCUSDT,spot@..." or
+ * "Not Subscribed successfully! [spot@...].  Reason: Blocked!"
+ * @param msg
+ * @return whole channel names, compared exactly, so a channel does not match a longer one it is a prefix of
+ */
+static std::set<std::string_view> controlMsgChannels(const std::string_view msg) {
+    auto list = msg;
+
+    if (const auto open = msg.find('['); open != std::string_view::npos) {
+        const auto close = msg.find(']', open);
+        list = msg.substr(open + 1, close == std::string_view::npos ? std::string_view::npos : close - open - 1);
+    }
+
+    std::set<std::string_view> retVal;
+
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        auto channel = list.substr(0, comma);
+
+        while (!channel.empty() && channel.front() == ' ') {
+            channel.remove_prefix(1);
+        }
+
+        while (!channel.empty() && channel.back() == ' ') {
+            channel.remove_suffix(1);
+        }
+
+        if (!channel.empty()) {
+            retVal.insert(channel);
+        }
+
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+    }
+
+    return retVal;
+}
+
+struct WebSocketSession::P {
+    boost::asio::ip::tcp::resolver resolver;
+    boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>> ws;
+    boost::beast::flat_buffer buffer;
+    std::string host;
+    std::string target;
+    std::set<std::string> subscriptions;
+    std::set<std::string> pendingSubscriptions;
+    std::deque<std::string> writeQueue;
+    bool isWriting{false};
+    bool isConnected{false};
+    onLogMessage logMessageCB;
+    onDataEvent dataEventCB;
+    onSessionClosed sessionClosedCB;
+    boost::asio::steady_timer pingTimer;
+    std::chrono::time_point<std::chrono::system_clock> lastPingTime{};
+    std::chrono::time_point<std::chrono::system_clock> lastPongTime{};
+    mutable std::mutex subscriptionLocker;
+
+    P(boost::asio::io_context &ioc, boost::asio::ssl::context &ctx, const onLogMessage &onLogMessageCB)
+        : resolver(make_strand(ioc)), ws(make_strand(ioc), ctx), logMessageCB(onLogMessageCB),
+          pingTimer(ws.get_executor()) {}
+
+    /// Called once, when the connection fails or the established connection is lost
+    void notifyClosed() {
+        pingTimer.cancel();
+
+        if (sessionClosedCB) {
+            const auto closedCB = std::move(sessionClosedCB);
+            sessionClosedCB = nullptr;
+            closedCB();
+        }
+    }
+
+    static std::string subscriptionMessage(const std::vector<std::string> &channels) {
+        nlohmann::json json;
+        json["method"] = "SUBSCRIPTION";
+        json["params"] = channels;
+        return json.dump();
+    }
+
+    /// Must be called on the session strand
+    void enqueue(const std::shared_ptr<WebSocketSession> &self, std::string message) {
+        writeQueue.push_back(std::move(message));
+
+        if (!isWriting) {
+            doWrite(self);
+        }
+    }
+
+    void doWrite(const std::shared_ptr<WebSocketSession> &self) {
+        isWriting = true;
+        ws.text(true);
+        ws.async_write(boost::asio::buffer(writeQueue.front()),
+                       [this, self](const boost::beast::error_code &ec, const std::size_t bytesTransferred) {
+                           onWrite(self, ec, bytesTransferred);
+                       });
+    }
+
+    void onWrite(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
+                 std::size_t bytesTransferred) {
+        boost::ignore_unused(bytesTransferred);
+
+        if (ec) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+
+            /// The stream is unusable, the pending read is aborted and the client reconnects with the subscriptions
+            {
+                std::lock_guard lk(subscriptionLocker);
+                isConnected = false;
+            }
+
+            writeQueue.clear();
+            isWriting = false;
+            boost::beast::error_code closeEc;
+            get_lowest_layer(ws).socket().close(closeEc);
+            return notifyClosed();
+        }
+
+        writeQueue.pop_front();
+
+        if (!writeQueue.empty()) {
+            doWrite(self);
+        } else {
+            isWriting = false;
+        }
+    }
+
+    void addSubscription(const std::shared_ptr<WebSocketSession> &self, const std::string &channel) {
+        {
+            std::lock_guard lk(subscriptionLocker);
+
+            if (!subscriptions.contains(channel) && !pendingSubscriptions.contains(channel) &&
+                subscriptions.size() + pendingSubscriptions.size() >= MAX_CHANNELS_PER_CONNECTION) {
+                throw std::runtime_error(fmt::format("Channel limit of {} per connection reached, not subscribed: {}",
+                                                     MAX_CHANNELS_PER_CONNECTION, channel));
+            }
+
+            if (subscriptions.contains(channel) || !pendingSubscriptions.insert(channel).second || !isConnected) {
+                /// Pending channels are sent once the connection is established
+                return;
+            }
+        }
+
+        boost::asio::post(ws.get_executor(), [this, self, channel] {
+            enqueue(self, subscriptionMessage({channel}));
+        });
+    }
+
+    [[nodiscard]] bool isSubscribed(const std::string &channel) const {
+        std::lock_guard lk(subscriptionLocker);
+        return subscriptions.contains(channel);
+    }
+
+    void handleControlMsg(const nlohmann::json &json) {
+        std::string msg;
+        int code = 0;
+
+        if (json.contains("msg") && json["msg"].is_string()) {
+            msg = json["msg"].get<std::string>();
+        }
+
+        if (json.contains("code") && json["code"].is_number()) {
+            code = json["code"].get<int>();
+        }
+
+        if (msg == "PONG") {
+            lastPongTime = std::chrono::system_clock::now();
+            return;
+        }
+
+        const auto channels = controlMsgChannels(msg);
+        std::lock_guard lk(subscriptionLocker);
+
+        for (auto it = pendingSubscriptions.begin(); it != pendingSubscriptions.end();) {
+            if (!channels.contains(*it)) {
+                ++it;
+                continue;
+            }
+
+            if (code == 0 && !msg.starts_with("Not Subscribed")) {
+                subscriptions.insert(*it);
+            } else {
+                logMessageCB(LogSeverity::Error, fmt::format("MEXC API Error, subscription failed {}", *it));
+            }
+
+            it = pendingSubscriptions.erase(it);
+        }
+
+        logMessageCB(LogSeverity::Info, fmt::format("MEXC API control msg: {}", json.dump()));
+    }
+
+    void onResolve(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
+                   const boost::asio::ip::tcp::resolver::results_type &results) {
+        if (ec) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        get_lowest_layer(ws).expires_after(std::chrono::seconds(30));
+
+        get_lowest_layer(ws).async_connect(
+            results, [this, self](const boost::beast::error_code &e,
+                                  const boost::asio::ip::tcp::resolver::results_type::endpoint_type &ep) {
+                onConnect(self, e, ep);
+            });
+    }
+
+    void onConnect(const std::shared_ptr<WebSocketSession> &self, boost::beast::error_code ec,
+                   const boost::asio::ip::tcp::resolver::results_type::endpoint_type &ep) {
+        if (ec) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        get_lowest_layer(ws).expires_after(std::chrono::seconds(30));
+
+        if (!SSL_set_tlsext_host_name(ws.next_layer().native_handle(), host.c_str())) {
+            ec = boost::beast::error_code(static_cast<int>(ERR_get_error()), boost::asio::error::get_ssl_category());
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        host += ':' + std::to_string(ep.port());
+
+        ws.next_layer().async_handshake(boost::asio::ssl::stream_base::client,
+                                        [this, self](const boost::beast::error_code &e) { onSSLHandshake(self, e); });
+    }
+
+    void onSSLHandshake(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
+        if (ec) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        get_lowest_layer(ws).expires_never();
+
+        ws.set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::client));
+
+        ws.set_option(boost::beast::websocket::stream_base::decorator([](boost::beast::websocket::request_type &req) {
+            req.set(boost::beast::http::field::user_agent,
+                    std::string(BOOST_BEAST_VERSION_STRING) + " mexc-client");
+        }));
+
+        ws.async_handshake(host, target,
+                           [this, self](const boost::beast::error_code &e) { onHandshake(self, e); });
+    }
+
+    void onHandshake(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
+        if (ec) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        std::vector<std::string> channels;
+
+        {
+            std::lock_guard lk(subscriptionLocker);
+            isConnected = true;
+            channels.assign(pendingSubscriptions.begin(), pendingSubscriptions.end());
+        }
+
+        /// All pending channels go out in a single SUBSCRIPTION request
+        if (!channels.empty()) {
+            enqueue(self, subscriptionMessage(channels));
+        }
+
+        pingTimer.expires_after(std::chrono::seconds(PING_INTERVAL_IN_S));
+        pingTimer.async_wait([this, self](const boost::beast::error_code &e) { onPingTimer(self, e); });
+
+        ws.async_read(buffer, [this, self](const boost::beast::error_code &e, const std::size_t transferred) {
+            onRead(self, e, transferred);
+        });
+    }
+
+    void onRead(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec,
+                std::size_t bytesTransferred) {
+        boost::ignore_unused(bytesTransferred);
+
+        if (ec) {
+            pingTimer.cancel();
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            return notifyClosed();
+        }
+
+        const auto data = buffer.cdata();
+        const std::string_view frame(static_cast<const char *>(data.data()), data.size());
+
+        try {
+            if (ws.got_binary()) {
+                /// Market data are protobuf encoded, decode straight from the receive buffer
+                Event dataEvent;
+                dataEvent.fromProtobuf(frame);
+
+                if (dataEventCB) {
+                    dataEventCB(dataEvent);
+                }
+            } else if (const nlohmann::json json = nlohmann::json::parse(frame); json.is_object()) {
+                handleControlMsg(json);
+            }
+        } catch (std::exception &e) {
+            logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+        }
+
+        buffer.consume(buffer.size());
+
+        ws.async_read(buffer, [this, self](const boost::beast::error_code &e, const std::size_t transferred) {
+            onRead(self, e, transferred);
+        });
+    }
+
+    void ping(const std::shared_ptr<WebSocketSession> &self) {
+        if (const std::chrono::duration<double> elapsed = lastPingTime - lastPongTime;
+            elapsed.count() > PING_INTERVAL_IN_S) {
+            logMessageCB(LogSeverity::Warning, fmt::format("{}: {}", MAKE_FILELINE, "ping expired"));
+        }
+
+        if (ws.is_open()) {
+            enqueue(self, R"({"method":"PING"})");
+            lastPingTime = std::chrono::system_clock::now();
+        }
+    }
+
+    void closeWs() {
+        ws.async_close(boost::beast::websocket::close_code::normal,
+                       [this](const boost::beast::error_code &ec) { onClose(ec); });
+    }
+
+    void onClose(const boost::beast::error_code &ec) {
+        pingTimer.cancel();
+
+        if (ec) {
+            return logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+        }
+    }
+
+    void onPingTimer(const std::shared_ptr<WebSocketSession> &self, const boost::beast::error_code &ec) {
+        if (ec) {
+            if (ec != boost::asio::error::operation_aborted) {
+                logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, ec.message()));
+            }
+            return;
+        }
+
+        ping(self);
+        pingTimer.expires_after(std::chrono::seconds(PING_INTERVAL_IN_S));
+        pingTimer.async_wait([this, self](const boost::beast::error_code &e) { onPingTimer(self, e); });
+    }
+};
+
+WebSocketSession::WebSocketSession(boost::asio::io_context &ioc, boost::asio::ssl::context &ctx,
+                                   const onLogMessage &onLogMessageCB)
+    : m_p(std::make_unique<P>(ioc, ctx, onLogMessageCB)) {
+    m_p->logMessageCB(LogSeverity::Info, "Spot WebSocketSession created");
+}
+
+WebSocketSession::~WebSocketSession() {
+    m_p->pingTimer.cancel();
+    m_p->logMessageCB(LogSeverity::Info, "Spot WebSocketSession destroyed");
+}
+
+void WebSocketSession::subscribe(const std::string &channel) {
+    m_p->addSubscription(shared_from_this(), channel);
+}
+
+void WebSocketSession::setSessionClosedCallback(const onSessionClosed &sessionClosedCB) const {
+    m_p->sessionClosedCB = sessionClosedCB;
+}
+
+bool WebSocketSession::isSubscribed(const std::string &channel) const {
+    return m_p->isSubscribed(channel);
+}
+
+void WebSocketSession::run(const std::string &host, const std::string &port, const std::string &target,
+                           const std::vector<std::string> &channels, const onDataEvent &dataEventCB) {
+    m_p->host = host;
+    m_p->target = target;
+    m_p->dataEventCB = dataEventCB;
+
+    {
+        std::lock_guard lk(m_p->subscriptionLocker);
+        m_p->pendingSubscriptions.insert(channels.begin(), channels.end());
+    }
+
+    auto self = shared_from_this();
+    m_p->resolver.async_resolve(
+        host, port,
+        [this, self](const boost::beast::error_code &ec, const boost::asio::ip::tcp::resolver::results_type &results) {
+            m_p->onResolve(self, ec, results);
+        });
+}
+
+void WebSocketSession::close() const {
+    boost::asio::post(m_p->ws.get_executor(), [p = m_p.get(), self = shared_from_this()] { p->closeWs(); });
+}
+} // namespace vk::mexc::spot
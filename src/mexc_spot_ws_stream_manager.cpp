@@ -0,0 +1,144 @@
+/**
+MEXC Spot WebSocket Stream manager
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_spot_ws_stream_manager.h"
+#include "vk/mexc/mexc_spot_ws_client.h"
+#include "vk/utils/utils.h"
+#include <mutex>
+#include <map>
+#include <fmt/format.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace vk::mexc::spot {
+struct WSStreamManager::P {
+	std::unique_ptr<WSClient> wsClient;
+	int timeout{5};
+	mutable std::recursive_mutex dealsLocker;
+	mutable std::recursive_mutex depthLocker;
+	mutable std::recursive_mutex candlestickLocker;
+	std::map<std::string, EventDeals> deals;
+	std::map<std::string, EventDepth> depths;
+	std::map<std::string, std::map<CandleInterval, EventCandlestick> > candlesticks;
+	onLogMessage logMessageCB;
+
+	explicit P() : wsClient(std::make_unique<WSClient>()) {
+		wsClient->setDataEventCallback([&](const Event &event) {
+			if (const auto *eventDeals = std::get_if<EventDeals>(&event.data)) {
+				std::lock_guard lk(dealsLocker);
+				deals.insert_or_assign(event.symbol, *eventDeals);
+			} else if (const auto *eventDepth = std::get_if<EventDepth>(&event.data)) {
+				std::lock_guard lk(depthLocker);
+				depths.insert_or_assign(event.symbol, *eventDepth);
+			} else if (const auto *eventCandlestick = std::get_if<EventCandlestick>(&event.data)) {
+				std::lock_guard lk(candlestickLocker);
+				candlesticks[event.symbol].insert_or_assign(eventCandlestick->interval, *eventCandlestick);
+			}
+		});
+	}
+
+	void subscribe(const std::string &channel) const {
+		if (!wsClient->isSubscribed(channel)) {
+			if (logMessageCB) {
+				logMessageCB(LogSeverity::Info, fmt::format("subscribing: {}", channel));
+			}
+
+			wsClient->subscribe(channel);
+		}
+
+		wsClient->run();
+	}
+
+	/// Poll the cache until the value appears or the timeout expires
+	template<typename ValueType, typename Lookup>
+	std::optional<ValueType> read(std::recursive_mutex &locker, const Lookup &lookup) const {
+		int numTries = 0;
+		const int maxNumTries = static_cast<int>(timeout / 0.01);
+
+		while (numTries <= maxNumTries) {
+			if (timeout == 0) {
+				/// No need to wait when destroying object
+				break;
+			}
+
+			{
+				std::lock_guard lk(locker);
+
+				if (const ValueType *value = lookup()) {
+					return *value;
+				}
+			}
+
+			numTries++;
+			std::this_thread::sleep_for(3ms);
+		}
+
+		return {};
+	}
+};
+
+WSStreamManager::WSStreamManager() : m_p(std::make_unique<P>()) {
+}
+
+WSStreamManager::~WSStreamManager() {
+	m_p->wsClient.reset();
+	m_p->timeout = 0;
+}
+
+void WSStreamManager::subscribeDealsStream(const std::string &pair) const {
+	m_p->subscribe(fmt::format("spot@public.aggre.deals.v3.api.pb@100ms@{}", pair));
+}
+
+void WSStreamManager::subscribeDepthStream(const std::string &pair, const int levels) const {
+	m_p->subscribe(fmt::format("spot@public.limit.depth.v3.api.pb@{}@{}", pair, levels));
+}
+
+void WSStreamManager::subscribeCandlestickStream(const std::string &pair, const CandleInterval interval) const {
+	m_p->subscribe(fmt::format("spot@public.kline.v3.api.pb@{}@{}", pair, magic_enum::enum_name(interval)));
+}
+
+void WSStreamManager::setTimeout(const int seconds) const {
+	m_p->timeout = seconds;
+}
+
+int WSStreamManager::timeout() const {
+	return m_p->timeout;
+}
+
+void WSStreamManager::setLoggerCallback(const onLogMessage &onLogMessageCB) const {
+	m_p->logMessageCB = onLogMessageCB;
+	m_p->wsClient->setLoggerCallback(onLogMessageCB);
+}
+
+std::optional<EventDeals> WSStreamManager::readEventDeals(const std::string &pair) const {
+	return m_p->read<EventDeals>(m_p->dealsLocker, [&]() -> const EventDeals * {
+		const auto it = m_p->deals.find(pair);
+		return it != m_p->deals.end() ? &it->second : nullptr;
+	});
+}
+
+std::optional<EventDepth> WSStreamManager::readEventDepth(const std::string &pair) const {
+	return m_p->read<EventDepth>(m_p->depthLocker, [&]() -> const EventDepth * {
+		const auto it = m_p->depths.find(pair);
+		return it != m_p->depths.end() ? &it->second : nullptr;
+	});
+}
+
+std::optional<EventCandlestick>
+WSStreamManager::readEventCandlestick(const std::string &pair, const CandleInterval interval) const {
+	return m_p->read<EventCandlestick>(m_p->candlestickLocker, [&]() -> const EventCandlestick * {
+		if (const auto it = m_p->candlesticks.find(pair); it != m_p->candlesticks.end()) {
+			if (const auto itCandle = it->second.find(interval); itCandle != it->second.end()) {
+				return &itCandle->second;
+			}
+		}
+		return nullptr;
+	});
+}
+}
@@ -0,0 +1,86 @@
+/**
+MEXC Symbol Registry
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_symbol_registry.h"
+#include "vk/mexc/mexc_models.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace vk::mexc {
+struct SymbolRegistry::P {
+    mutable std::shared_mutex mutex;
+
+    /// Deque keeps the strings at their addresses, the map keys and the returned names point into them
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, SymbolId> ids;
+
+    SymbolId insert(const std::string_view symbol) {
+        if (const auto it = ids.find(symbol); it != ids.end()) {
+            return it->second;
+        }
+
+        if (names.size() >= INVALID_SYMBOL_ID) {
+            throw std::runtime_error("Symbol registry is full");
+        }
+
+        const auto id = static_cast<SymbolId>(names.size());
+        ids.emplace(names.emplace_back(symbol), id);
+        return id;
+    }
+};
+
+SymbolRegistry::SymbolRegistry() : m_p(std::make_unique<P>()) {
+}
+
+SymbolRegistry::~SymbolRegistry() = default;
+
+SymbolRegistry &SymbolRegistry::instance() {
+    static SymbolRegistry registry;
+    return registry;
+}
+
+SymbolId SymbolRegistry::intern(const std::string_view symbol) const {
+    if (const auto id = find(symbol)) {
+        return *id;
+    }
+
+    std::unique_lock lock(m_p->mutex);
+    return m_p->insert(symbol);
+}
+
+void SymbolRegistry::seed(const std::vector<futures::ContractDetail> &contractDetails) const {
+    std::unique_lock lock(m_p->mutex);
+
+    for (const auto &contractDetail: contractDetails) {
+        m_p->insert(contractDetail.symbol);
+    }
+}
+
+std::optional<SymbolId> SymbolRegistry::find(const std::string_view symbol) const {
+    std::shared_lock lock(m_p->mutex);
+
+    if (const auto it = m_p->ids.find(symbol); it != m_p->ids.end()) {
+        return it->second;
+    }
+
+    return std::nullopt;
+}
+
+std::string_view SymbolRegistry::name(const SymbolId id) const {
+    std::shared_lock lock(m_p->mutex);
+    return id < m_p->names.size() ? std::string_view(m_p->names[id]) : std::string_view();
+}
+
+std::size_t SymbolRegistry::size() const {
+    std::shared_lock lock(m_p->mutex);
+    return m_p->names.size();
+}
+}
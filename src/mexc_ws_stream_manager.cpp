@@ -10,57 +10,313 @@ Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
 #include "vk/mexc/mexc_ws_stream_manager.h"
 #include "vk/mexc/mexc_futures_ws_client.h"
 #include "vk/utils/utils.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <fmt/format.h>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
 namespace vk::mexc::futures {
+constexpr std::size_t CANDLE_INTERVAL_COUNT = static_cast<std::size_t>(CandleInterval::_1M) + 1;
+
+/// Delay before the next snapshot when the previous one failed or was older than the buffered updates
+constexpr auto RESYNC_RETRY_DELAY = 500ms;
+
 struct WSStreamManager::P {
 	std::unique_ptr<WSClient> wsClient;
 	int timeout{5};
 	mutable std::recursive_mutex instrumentInfoLocker;
 	mutable std::recursive_mutex candlestickLocker;
-	std::map<std::string, EventTicker> tickers;
-	std::map<std::string, std::map<CandleInterval, EventCandlestick> > candlesticks;
+
+	/// Caches indexed by SymbolId, see SymbolRegistry
+	std::vector<std::optional<EventTicker> > tickers;
+	std::vector<std::array<std::optional<EventCandlestick>, CANDLE_INTERVAL_COUNT> > candlesticks;
 	onLogMessage logMessageCB;
 
-	explicit P() : wsClient(std::make_unique<WSClient>()) {
-		wsClient->setDataEventCallback([&](const Event &event) {
-			if (event.channel.find("push.ticker") != std::string::npos) {
-				std::lock_guard lk(instrumentInfoLocker);
+	/// Guards the container only, the books are read without locking
+	mutable std::mutex bookLocker;
+	std::vector<std::shared_ptr<OrderBook> > books;
+
+	/// Snapshots are fetched by the resync thread, the IO thread only queues the symbols
+	std::unique_ptr<RESTClient> restClient;
+	std::thread resyncThread;
+	std::mutex resyncLocker;
+	std::condition_variable resyncCondition;
+	std::deque<std::pair<SymbolId, std::chrono::steady_clock::time_point> > resyncQueue;
+	bool isStopping{false};
+
+	template<typename T>
+	static T &slot(std::vector<T> &cache, const SymbolId symbolId) {
+		if (cache.size() <= symbolId) {
+			cache.resize(std::max<std::size_t>(symbolId + 1, SymbolRegistry::instance().size()));
+		}
 
-				try {
-					if (const auto it = tickers.find(event.symbol); it == tickers.end()) {
-						EventTicker eventTicker;
-						eventTicker.fromJson(event.data);
-						tickers.insert_or_assign(eventTicker.symbol, eventTicker);
-					} else {
-						it->second.fromJson(event.data);
-					}
-				} catch (std::exception &e) {
-					logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
-				}
-			} else if (event.channel.find("push.kline") != std::string::npos) {
-				std::lock_guard lk(candlestickLocker);
+		return cache[symbolId];
+	}
 
-				try {
-					EventCandlestick eventCandlestick;
-					eventCandlestick.fromJson(event.data);
+	template<typename Read>
+	auto waitFor(Read read) const -> decltype(read()) {
+		int numTries = 0;
+		const int maxNumTries = static_cast<int>(timeout / 0.01);
 
-					auto it = candlesticks.find(event.symbol);
+		while (numTries <= maxNumTries) {
+			if (timeout == 0) {
+				/// No need to wait when destroying object
+				break;
+			}
 
-					if (it == candlesticks.end()) {
-						candlesticks.insert({event.symbol, {}});
-					}
+			if (auto retVal = read()) {
+				return retVal;
+			}
+
+			numTries++;
+			std::this_thread::sleep_for(3ms);
+		}
+
+		return {};
+	}
+
+	template<typename Read>
+	auto waitFor(std::recursive_mutex &locker, Read read) const -> decltype(read()) {
+		return waitFor([&]() -> decltype(read()) {
+			std::lock_guard lk(locker);
+			return read();
+		});
+	}
 
-					it = candlesticks.find(event.symbol);
-					it->second.insert_or_assign(eventCandlestick.interval, eventCandlestick);
-				} catch (std::exception &e) {
-					logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+	void subscribe(const WSSubscription &subscriptionRequest) const {
+		if (!wsClient->isSubscribed(subscriptionRequest.toJson())) {
+			if (logMessageCB) {
+				const auto msgString = fmt::format("subscribing: {}", subscriptionRequest.toJson().dump());
+				logMessageCB(LogSeverity::Info, msgString);
+			}
+
+			wsClient->subscribe(subscriptionRequest.toJson());
+		}
+
+		wsClient->run();
+	}
+
+	std::shared_ptr<OrderBook> findBook(const SymbolId symbolId) const {
+		std::lock_guard lk(bookLocker);
+		return symbolId < books.size() ? books[symbolId] : nullptr;
+	}
+
+	std::shared_ptr<OrderBook> addBook(const SymbolId symbolId) {
+		std::lock_guard lk(bookLocker);
+		auto &book = slot(books, symbolId);
+
+		if (!book) {
+			book = std::make_shared<OrderBook>();
+		}
+
+		return book;
+	}
+
+	/// Symbols of the depth subscriptions among the requests, isIncremental selects sub.depth or sub.depth.full
+	static std::vector<SymbolId> depthSymbols(const std::vector<nlohmann::json> &subscriptions,
+											  const bool isIncremental) {
+		std::vector<SymbolId> retVal;
+
+		for (const auto &subscription: subscriptions) {
+			const auto method = subscription.value("method", std::string());
+
+			if (method != "sub.depth" && (isIncremental || method != "sub.depth.full")) {
+				continue;
+			}
+
+			if (const auto param = subscription.find("param"); param != subscription.end() && param->is_object()) {
+				if (const auto symbolId = SymbolRegistry::instance().find(param->value("symbol", std::string()))) {
+					retVal.push_back(*symbolId);
 				}
 			}
+		}
+
+		return retVal;
+	}
+
+	/// The books of the lost connection miss updates from now on, readers must not see them as in sync
+	void onConnectionLost(const StreamGap &streamGap) const {
+		for (const auto symbolId: depthSymbols(streamGap.subscriptions, false)) {
+			if (const auto book = findBook(symbolId)) {
+				book->invalidate();
+			}
+		}
+
+		if (logMessageCB) {
+			logMessageCB(LogSeverity::Warning, fmt::format("order books of connection {} invalidated",
+														   streamGap.connection));
+		}
+	}
+
+	/**
+	 * The updates published within the gap are lost, the incremental books are resynced from a snapshot now that
+	 * the updates are buffered again. They are invalidated once more, a resync finished during the outage may have
+	 * marked them in sync, the first frame of the new connection is dispatched after this. The full depth books are
+	 * replaced by the next push.
+	 */
+	void onStreamGap(const StreamGap &streamGap) {
+		const auto now = std::chrono::steady_clock::now();
+
+		for (const auto symbolId: depthSymbols(streamGap.subscriptions, false)) {
+			if (const auto book = findBook(symbolId)) {
+				book->invalidate();
+			}
+		}
+
+		for (const auto symbolId: depthSymbols(streamGap.subscriptions, true)) {
+			if (findBook(symbolId)) {
+				requestResync(symbolId, now);
+			}
+		}
+	}
+
+	void onEventDepth(const EventDepth &eventDepth) {
+		const auto book = findBook(eventDepth.symbolId);
+
+		if (!book) {
+			return;
+		}
+
+		if (eventDepth.isSnapshot) {
+			book->applySnapshot(eventDepth);
+		} else if (book->apply(eventDepth) == BookUpdate::Gap) {
+			if (logMessageCB) {
+				logMessageCB(LogSeverity::Warning, fmt::format("order book gap: {}, version: {}", eventDepth.symbol,
+															   eventDepth.version));
+			}
+
+			requestResync(eventDepth.symbolId, std::chrono::steady_clock::now());
+		}
+	}
+
+	/// Must be called with resyncLocker locked
+	void enqueueResync(const SymbolId symbolId, const std::chrono::steady_clock::time_point notBefore) {
+		if (std::ranges::none_of(resyncQueue, [&](const auto &entry) { return entry.first == symbolId; })) {
+			resyncQueue.emplace_back(symbolId, notBefore);
+		}
+	}
+
+	void requestResync(const SymbolId symbolId, const std::chrono::steady_clock::time_point notBefore) {
+		std::lock_guard lk(resyncLocker);
+
+		if (isStopping) {
+			return;
+		}
+
+		enqueueResync(symbolId, notBefore);
+
+		if (!resyncThread.joinable()) {
+			restClient = std::make_unique<RESTClient>("", "");
+			resyncThread = std::thread(&P::resyncLoop, this);
+		}
+
+		resyncCondition.notify_one();
+	}
+
+	void resyncLoop() {
+		std::unique_lock lk(resyncLocker);
+
+		while (!isStopping) {
+			const auto it = std::ranges::min_element(resyncQueue, [](const auto &lhs, const auto &rhs) {
+				return lhs.second < rhs.second;
+			});
+
+			if (it == resyncQueue.end()) {
+				resyncCondition.wait(lk);
+				continue;
+			}
+
+			if (it->second > std::chrono::steady_clock::now()) {
+				resyncCondition.wait_until(lk, it->second);
+				continue;
+			}
+
+			const auto symbolId = it->first;
+			resyncQueue.erase(it);
+			lk.unlock();
+
+			const auto isSynced = resync(symbolId);
+
+			lk.lock();
+
+			if (!isSynced && !isStopping) {
+				enqueueResync(symbolId, std::chrono::steady_clock::now() + RESYNC_RETRY_DELAY);
+			}
+		}
+	}
+
+	/// Fetch snapshot of the order book and replay the buffered updates on top of it
+	bool resync(const SymbolId symbolId) const {
+		const auto book = findBook(symbolId);
+
+		if (!book) {
+			return true;
+		}
+
+		try {
+			auto depth = restClient->getContractDepth(std::string(SymbolRegistry::instance().name(symbolId)));
+			EventDepth snapshot;
+			snapshot.symbolId = symbolId;
+			snapshot.isSnapshot = true;
+			snapshot.version = depth.version;
+			snapshot.ts = depth.timestamp;
+			snapshot.asks = std::move(depth.asks);
+			snapshot.bids = std::move(depth.bids);
+			return book->applySnapshot(snapshot);
+		} catch (std::exception &e) {
+			if (logMessageCB) {
+				logMessageCB(LogSeverity::Error, fmt::format("{}: {}", MAKE_FILELINE, e.what()));
+			}
+		}
+
+		return false;
+	}
+
+	void stopResync() {
+		{
+			std::lock_guard lk(resyncLocker);
+			isStopping = true;
+			resyncCondition.notify_one();
+		}
+
+		if (resyncThread.joinable()) {
+			resyncThread.join();
+		}
+	}
+
+	explicit P() : wsClient(std::make_unique<WSClient>()) {
+		/// Typed callbacks, the ticker and candlestick frames are decoded without a JSON DOM
+		wsClient->setEventTickerCallback([&](const EventTicker &eventTicker) {
+			if (eventTicker.symbolId != INVALID_SYMBOL_ID) {
+				std::lock_guard lk(instrumentInfoLocker);
+				slot(tickers, eventTicker.symbolId) = eventTicker;
+			}
+		});
+
+		wsClient->setEventCandlestickCallback([&](const EventCandlestick &eventCandlestick) {
+			if (const auto interval = static_cast<std::size_t>(eventCandlestick.interval);
+				eventCandlestick.symbolId != INVALID_SYMBOL_ID && interval < CANDLE_INTERVAL_COUNT) {
+				std::lock_guard lk(candlestickLocker);
+				slot(candlesticks, eventCandlestick.symbolId)[interval] = eventCandlestick;
+			}
+		});
+
+		wsClient->setEventDepthCallback([&](const EventDepth &eventDepth) {
+			onEventDepth(eventDepth);
+		});
+
+		wsClient->setConnectionLostCallback([&](const StreamGap &streamGap) {
+			onConnectionLost(streamGap);
+		});
+
+		wsClient->setStreamGapCallback([&](const StreamGap &streamGap) {
+			onStreamGap(streamGap);
 		});
 	}
 };
@@ -70,6 +326,7 @@ WSStreamManager::WSStreamManager() : m_p(std::make_unique<P>()) {
 
 WSStreamManager::~WSStreamManager() {
 	m_p->wsClient.reset();
+	m_p->stopResync();
 	m_p->timeout = 0;
 }
 
@@ -77,17 +334,7 @@ void WSStreamManager::subscribeTickerStream(const std::string &pair) const {
 	WSSubscription subscriptionRequest;
 	subscriptionRequest.method = "sub.ticker";
 	subscriptionRequest.parameters.symbol = pair;
-
-	if (!m_p->wsClient->isSubscribed(subscriptionRequest.toJson())) {
-		if (m_p->logMessageCB) {
-			const auto msgString = fmt::format("subscribing: {}", subscriptionRequest.toJson().dump());
-			m_p->logMessageCB(LogSeverity::Info, msgString);
-		}
-
-		m_p->wsClient->subscribe(subscriptionRequest.toJson());
-	}
-
-	m_p->wsClient->run();
+	m_p->subscribe(subscriptionRequest);
 }
 
 void WSStreamManager::subscribeCandlestickStream(const std::string &pair, const CandleInterval interval) const {
@@ -95,17 +342,28 @@ void WSStreamManager::subscribeCandlestickStream(const std::string &pair, const
 	subscriptionRequest.method = "sub.kline";
 	subscriptionRequest.parameters.symbol = pair;
 	subscriptionRequest.parameters.interval = magic_enum::enum_name(interval);
+	m_p->subscribe(subscriptionRequest);
+}
 
-	if (!m_p->wsClient->isSubscribed(subscriptionRequest.toJson())) {
-		if (m_p->logMessageCB) {
-			const auto msgString = fmt::format("subscribing: {}", subscriptionRequest.toJson().dump());
-			m_p->logMessageCB(LogSeverity::Info, msgString);
-		}
-
-		m_p->wsClient->subscribe(subscriptionRequest.toJson());
+void WSStreamManager::subscribeDepthStream(const std::string &pair) const {
+	if (const auto symbolId = SymbolRegistry::instance().intern(pair); !m_p->addBook(symbolId)->isSynced()) {
+		m_p->requestResync(symbolId, std::chrono::steady_clock::now());
 	}
 
-	m_p->wsClient->run();
+	WSSubscription subscriptionRequest;
+	subscriptionRequest.method = "sub.depth";
+	subscriptionRequest.parameters.symbol = pair;
+	m_p->subscribe(subscriptionRequest);
+}
+
+void WSStreamManager::subscribeFullDepthStream(const std::string &pair, const int limit) const {
+	m_p->addBook(SymbolRegistry::instance().intern(pair));
+
+	WSSubscription subscriptionRequest;
+	subscriptionRequest.method = "sub.depth.full";
+	subscriptionRequest.parameters.symbol = pair;
+	subscriptionRequest.parameters.limit = limit;
+	m_p->subscribe(subscriptionRequest);
 }
 
 void WSStreamManager::setTimeout(const int seconds) const {
@@ -122,56 +380,78 @@ void WSStreamManager::setLoggerCallback(const onLogMessage &onLogMessageCB) cons
 }
 
 std::optional<EventTicker> WSStreamManager::readEventTicker(const std::string &pair) const {
-	int numTries = 0;
-	const int maxNumTries = static_cast<int>(m_p->timeout / 0.01);
-
-	while (numTries <= maxNumTries) {
-		if (m_p->timeout == 0) {
-			/// No need to wait when destroying object
-			break;
+	/// The pair is looked up on each try, it gets its ID with the first event, unknown pairs are not interned
+	return m_p->waitFor(m_p->instrumentInfoLocker, [&]() -> std::optional<EventTicker> {
+		if (const auto symbolId = SymbolRegistry::instance().find(pair); symbolId && *symbolId < m_p->tickers.size()) {
+			return m_p->tickers[*symbolId];
 		}
 
-		m_p->instrumentInfoLocker.lock();
-
-		if (const auto it = m_p->tickers.find(pair); it != m_p->tickers.end()) {
-			auto retVal = it->second;
+		return {};
+	});
+}
 
-			m_p->instrumentInfoLocker.unlock();
-			return retVal;
+std::optional<EventTicker> WSStreamManager::readEventTicker(const SymbolId symbolId) const {
+	return m_p->waitFor(m_p->instrumentInfoLocker, [&]() -> std::optional<EventTicker> {
+		if (symbolId < m_p->tickers.size()) {
+			return m_p->tickers[symbolId];
 		}
-		m_p->instrumentInfoLocker.unlock();
-		numTries++;
-		std::this_thread::sleep_for(3ms);
-	}
 
-	return {};
+		return {};
+	});
 }
 
 std::optional<EventCandlestick>
 WSStreamManager::readEventCandlestick(const std::string &pair, const CandleInterval interval) const {
-	int numTries = 0;
-	const int maxNumTries = static_cast<int>(m_p->timeout / 0.01);
-
-	while (numTries <= maxNumTries) {
-		if (m_p->timeout == 0) {
-			/// No need to wait when destroying object
-			break;
+	return m_p->waitFor(m_p->candlestickLocker, [&]() -> std::optional<EventCandlestick> {
+		if (const auto symbolId = SymbolRegistry::instance().find(pair);
+			symbolId && *symbolId < m_p->candlesticks.size()) {
+			return m_p->candlesticks[*symbolId].at(static_cast<std::size_t>(interval));
 		}
 
-		m_p->candlestickLocker.lock();
+		return {};
+	});
+}
 
-		if (const auto it = m_p->candlesticks.find(pair); it != m_p->candlesticks.end()) {
-			if (const auto itCandle = it->second.find(interval); itCandle != it->second.end()) {
-				auto retVal = itCandle->second;
-				m_p->candlestickLocker.unlock();
-				return retVal;
-			}
+std::optional<EventCandlestick>
+WSStreamManager::readEventCandlestick(const SymbolId symbolId, const CandleInterval interval) const {
+	return m_p->waitFor(m_p->candlestickLocker, [&]() -> std::optional<EventCandlestick> {
+		if (symbolId < m_p->candlesticks.size()) {
+			return m_p->candlesticks[symbolId].at(static_cast<std::size_t>(interval));
 		}
-		m_p->candlestickLocker.unlock();
-		numTries++;
-		std::this_thread::sleep_for(3ms);
+
+		return {};
+	});
+}
+
+std::shared_ptr<const OrderBook> WSStreamManager::orderBook(const std::string &pair) const {
+	if (const auto symbolId = SymbolRegistry::instance().find(pair)) {
+		return m_p->findBook(*symbolId);
+	}
+
+	return nullptr;
+}
+
+std::optional<BookTop> WSStreamManager::readBookTop(const std::string &pair) const {
+	const auto book = orderBook(pair);
+
+	if (!book) {
+		return {};
+	}
+
+	return m_p->waitFor([&] {
+		return book->top();
+	});
+}
+
+std::optional<BookDepth> WSStreamManager::readBookDepth(const std::string &pair, const std::size_t levels) const {
+	const auto book = orderBook(pair);
+
+	if (!book) {
+		return {};
 	}
 
-	return {};
+	return m_p->waitFor([&] {
+		return book->depth(levels);
+	});
 }
 }
@@ -0,0 +1,172 @@
+/**
+MEXC Binary Format Benchmark
+
+Compares the size, encode and decode time of the binary format with JSON on candles and contract details. Candle and
+ContractDetail have no toJson, the JSON side is written in the shape of the REST responses and decoded by their
+fromJson.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_binary_format.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <string>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int CANDLES = 2000;
+constexpr int CONTRACTS = 800;
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+std::vector<Candle> makeCandles() {
+    std::vector<Candle> retVal(CANDLES);
+
+    for (int i = 0; i < CANDLES; ++i) {
+        auto &candle = retVal[i];
+        candle.openTime = 1700000000000 + static_cast<std::int64_t>(i) * 60000;
+        candle.open = Price(std::to_string(27000 + i % 500) + ".5");
+        candle.high = Price(std::to_string(27010 + i % 500) + ".25");
+        candle.low = Price(std::to_string(26990 + i % 500) + ".75");
+        candle.close = Price(std::to_string(27005 + i % 500) + ".1");
+        candle.volume = Quantity(std::to_string(1000 + i));
+        candle.amount = Quantity(std::to_string(27000000 + i * 13) + ".5");
+    }
+
+    return retVal;
+}
+
+std::vector<ContractDetail> makeContractDetails() {
+    std::vector<ContractDetail> retVal(CONTRACTS);
+
+    for (int i = 0; i < CONTRACTS; ++i) {
+        auto &detail = retVal[i];
+        const auto base = "COIN" + std::to_string(i);
+        detail.symbol = base + "_USDT";
+        detail.displayNameEn = base + "_USDT PERPETUAL";
+        detail.baseCoin = base;
+        detail.quoteCoin = "USDT";
+        detail.settleCoin = "USDT";
+        detail.contractSize = 0.0001;
+        detail.priceUnit = 0.1;
+        detail.maxVol = 1250000;
+        detail.pricePrecision = 1;
+        detail.conceptPlate = {"mc-trade-zone-pow", "mc-trade-zone-layer-one"};
+    }
+
+    return retVal;
+}
+
+/// Kline response, one array per column, time in seconds
+std::string candlesToJson(const std::vector<Candle> &candles) {
+    nlohmann::json data;
+
+    for (const auto &candle: candles) {
+        data["time"].push_back(candle.openTime / 1000);
+        data["open"].push_back(candle.open.convert_to<double>());
+        data["high"].push_back(candle.high.convert_to<double>());
+        data["low"].push_back(candle.low.convert_to<double>());
+        data["close"].push_back(candle.close.convert_to<double>());
+        data["vol"].push_back(candle.volume.convert_to<double>());
+        data["amount"].push_back(candle.amount.convert_to<double>());
+    }
+
+    return nlohmann::json{{"success", true}, {"code", 0}, {"data", data}}.dump();
+}
+
+std::string contractDetailsToJson(const std::vector<ContractDetail> &details) {
+    nlohmann::json data = nlohmann::json::array();
+
+    for (const auto &detail: details) {
+        data.push_back({
+            {"symbol", detail.symbol}, {"displayNameEn", detail.displayNameEn}, {"baseCoin", detail.baseCoin},
+            {"quoteCoin", detail.quoteCoin}, {"settleCoin", detail.settleCoin},
+            {"state", static_cast<std::int32_t>(detail.state)}, {"apiAllowed", detail.apiAllowed},
+            {"automaticDelivery", detail.automaticDelivery}, {"contractSize", detail.contractSize},
+            {"minVol", detail.minVol}, {"maxVol", detail.maxVol}, {"volUnit", detail.volUnit},
+            {"priceUnit", detail.priceUnit}, {"pricePrecision", detail.pricePrecision},
+            {"volPrecision", detail.volPrecision}, {"conceptPlate", detail.conceptPlate}
+        });
+    }
+
+    return nlohmann::json{{"success", true}, {"code", 0}, {"data", data}}.dump();
+}
+
+template<typename T, typename ToJson, typename FromJson, typename Field>
+void run(const std::string &name, const std::vector<T> &items, ToJson toJson, FromJson fromJson, Field field) {
+    std::string json;
+    std::string binary;
+    std::size_t decoded = 0;
+    double sum = 0.0;
+
+    const auto jsonEncodeTime = measure([&] {
+        json = toJson(items);
+    });
+
+    const auto binaryEncodeTime = measure([&] {
+        binary = encodeBinary(items);
+    });
+
+    const auto jsonDecodeTime = measure([&] {
+        decoded += fromJson(json);
+    });
+
+    const auto binaryDecodeTime = measure([&] {
+        decoded += decodeBinary<T>(binary).size();
+    });
+
+    /// One field of every record read in place, without decoding the records
+    const auto viewTime = measure([&] {
+        const BinaryView<T> view(binary);
+
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            sum += field(view[i]);
+        }
+    });
+
+    const auto count = static_cast<double>(items.size());
+    spdlog::info("{:<15} JSON: {:>7} B, encode {:>6.1f} ns, decode {:>6.1f} ns | binary: {:>7} B, encode {:>6.1f} ns, "
+                 "decode {:>6.1f} ns, one field via BinaryView {:>5.1f} ns, per record (checks {} {})",
+                 name, json.size(), jsonEncodeTime / count, jsonDecodeTime / count, binary.size(),
+                 binaryEncodeTime / count, binaryDecodeTime / count, viewTime / count, decoded, sum);
+}
+}
+
+int main() {
+    run<Candle>("Candle", makeCandles(), candlesToJson,
+                [](const std::string &json) {
+                    Candles candles;
+                    JsonScanner scanner(json);
+                    candles.fromJson(scanner);
+                    return candles.candles.size();
+                },
+                [](const BinaryRecord<Candle> &record) {
+                    return record.get<&Candle::close>().convert_to<double>();
+                });
+
+    run<ContractDetail>("ContractDetail", makeContractDetails(), contractDetailsToJson,
+                        [](const std::string &json) {
+                            ContractDetails details;
+                            details.fromJson(nlohmann::json::parse(json));
+                            return details.contractDetails.size();
+                        },
+                        [](const BinaryRecord<ContractDetail> &record) {
+                            return record.get<&ContractDetail::priceUnit>();
+                        });
+    return 0;
+}
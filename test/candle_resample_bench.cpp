@@ -0,0 +1,125 @@
+/**
+MEXC Candle Resample Benchmark
+
+Compares the row by row resample which reduced each bucket with std::max_element, std::min_element and
+std::accumulate with the column kernels of resample().
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_candle_columns.h"
+#include "vk/mexc/mexc.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <spdlog/spdlog.h>
+
+using namespace vk::mexc;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr std::size_t CANDLES = 1 << 20;
+constexpr std::int64_t MINUTE_MS = 60000;
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+/// Reference, buckets aligned to the epoch and reduced row by row
+CandleColumns scalarResample(const CandleColumns &candles, const std::int64_t intervalMs) {
+    CandleColumns retVal;
+
+    for (std::size_t first = 0; first < candles.size();) {
+        const auto bucket = candles.openTime[first] - candles.openTime[first] % intervalMs;
+        auto last = first + 1;
+
+        while (last < candles.size() && candles.openTime[last] < bucket + intervalMs) {
+            ++last;
+        }
+
+        const auto begin = static_cast<std::ptrdiff_t>(first);
+        const auto end = static_cast<std::ptrdiff_t>(last);
+        retVal.push_back(bucket,
+                         candles.open[first],
+                         *std::max_element(candles.high.begin() + begin, candles.high.begin() + end),
+                         *std::min_element(candles.low.begin() + begin, candles.low.begin() + end),
+                         candles.close[last - 1],
+                         std::accumulate(candles.volume.begin() + begin, candles.volume.begin() + end, 0.0),
+                         std::accumulate(candles.amount.begin() + begin, candles.amount.begin() + end, 0.0));
+        first = last;
+    }
+
+    return retVal;
+}
+
+CandleColumns randomWalk() {
+    std::mt19937_64 generator(42);
+    std::normal_distribution<double> step(0.0, 5.0);
+    std::exponential_distribution<double> volume(0.1);
+    CandleColumns retVal;
+    retVal.reserve(CANDLES);
+    double price = 30000.0;
+
+    for (std::size_t i = 0; i < CANDLES; ++i) {
+        const auto open = price;
+        price += step(generator);
+        const auto high = std::max(open, price) + std::abs(step(generator));
+        const auto low = std::min(open, price) - std::abs(step(generator));
+        const auto v = volume(generator);
+        retVal.push_back(static_cast<std::int64_t>(i) * MINUTE_MS, open, high, low, price, v, v * price);
+    }
+
+    return retVal;
+}
+
+double maxDifference(const std::vector<double> &a, const std::vector<double> &b) {
+    double retVal = 0.0;
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        retVal = std::max(retVal, std::abs(a[i] - b[i]) / std::max(1.0, std::abs(a[i])));
+    }
+
+    return retVal;
+}
+
+void run(const std::string &name, const CandleColumns &candles, const CandleInterval interval) {
+    const auto intervalMs = MEXC::numberOfMsForCandleInterval(interval);
+    CandleColumns scalar;
+    CandleColumns kernel;
+
+    const auto scalarTime = measure([&] {
+        scalar = scalarResample(candles, intervalMs);
+    });
+
+    const auto kernelTime = measure([&] {
+        kernel = resample(candles, CandleInterval::_1m, interval);
+    });
+
+    const auto sameBuckets = scalar.openTime == kernel.openTime && scalar.high == kernel.high &&
+                             scalar.low == kernel.low;
+    const auto count = static_cast<double>(candles.size());
+    spdlog::info("1m -> {:<4} buckets: {:>6}, scalar: {:>5.2f} ns/candle, kernel: {:>5.2f} ns/candle, "
+                 "same buckets and extremes: {}, max relative volume difference: {:.1e}",
+                 name, kernel.size(), scalarTime / count, kernelTime / count, sameBuckets,
+                 maxDifference(scalar.volume, kernel.volume));
+}
+}
+
+int main() {
+    const auto candles = randomWalk();
+    run("5m", candles, CandleInterval::_5m);
+    run("60m", candles, CandleInterval::_60m);
+    run("1d", candles, CandleInterval::_1d);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+MEXC Channel Dispatch Benchmark
+
+Replays push frames on one core and reports frames per second of ChannelRegistry::dispatch, of the envelope scan with
+the dispatch as the session runs them, and of the whole path including the typed decoding. An unordered_map keyed by
+the channel name is measured as the baseline of the dispatch.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_channel_registry.h"
+#include "ws_replay_frames.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int FRAMES = 100000;
+
+/// Channels of a typical subscription set, the replayed frames use the first three
+const std::vector<std::string> CHANNELS = {
+    "push.ticker", "push.kline", "push.depth", "push.depth.full", "push.deal", "push.tickers", "push.funding.rate",
+    "push.index.price", "push.fair.price", "push.personal.order", "push.personal.position", "push.personal.asset",
+    "rs.sub.ticker", "rs.sub.kline", "rs.sub.depth", "rs.unsub.ticker", "rs.error"
+};
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+void report(const std::string &name, const double seconds) {
+    spdlog::info("{:<40} {:>7.2f} M frames/s, {:>6.1f} ns per frame", name, FRAMES / seconds / 1e6,
+                 seconds * 1e9 / FRAMES);
+}
+
+void pinToOneCore() {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        spdlog::warn("Could not pin the benchmark to CPU 0");
+    }
+#endif
+}
+}
+
+int main() {
+    pinToOneCore();
+
+    const auto frames = test::replayFrames(FRAMES);
+    std::vector<EventFrame> eventFrames(frames.size());
+
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        eventFrames[i].scan(frames[i]);
+    }
+
+    std::size_t dispatched = 0;
+    ChannelRegistry registry;
+    std::unordered_map<std::string, onChannelFrame> map;
+
+    for (const auto &channel: CHANNELS) {
+        const auto handler = [&dispatched](const EventFrame &) { ++dispatched; };
+        registry.set(channel, handler);
+        map.emplace(channel, handler);
+    }
+
+    report("ChannelRegistry::dispatch", measure([&] {
+        for (const auto &eventFrame: eventFrames) {
+            registry.dispatch(eventFrame);
+        }
+    }));
+
+    report("unordered_map<std::string> find + call", measure([&] {
+        for (const auto &eventFrame: eventFrames) {
+            if (const auto it = map.find(std::string(eventFrame.channel)); it != map.end()) {
+                it->second(eventFrame);
+            }
+        }
+    }));
+
+    report("EventFrame::scan + dispatch", measure([&] {
+        for (const auto &frame: frames) {
+            EventFrame eventFrame;
+
+            if (eventFrame.scan(frame)) {
+                registry.dispatch(eventFrame);
+            }
+        }
+    }));
+
+    EventTicker ticker;
+    EventCandlestick candlestick;
+    EventDepth depth;
+    ChannelRegistry decoding = registry;
+    decoding.set("push.ticker", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        ticker.fromJson(scanner);
+    });
+    decoding.set("push.kline", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        candlestick.fromJson(scanner);
+    });
+    decoding.set("push.depth", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        depth.fromJson(scanner);
+    });
+
+    report("EventFrame::scan + dispatch + decode", measure([&] {
+        for (const auto &frame: frames) {
+            EventFrame eventFrame;
+
+            if (eventFrame.scan(frame)) {
+                decoding.dispatch(eventFrame);
+            }
+        }
+    }));
+
+    spdlog::info("channels: {}, frames: {}, dispatched without decoding: {}", CHANNELS.size(), FRAMES, dispatched);
+    return 0;
+}
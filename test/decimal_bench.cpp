@@ -0,0 +1,103 @@
+/**
+MEXC Decimal Benchmark
+
+Compares parse, copy and conversion cost of cpp_dec_float_50 used by the models before, FixedDecimal and Decimal.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_fixed_decimal.h"
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+using namespace vk::mexc;
+
+namespace {
+constexpr int ROUNDS = 20;
+
+/// Values as MEXC sends them, from sub-satoshi spot prices to base asset volumes of the large pairs
+const std::vector<std::string> TEXTS = {
+    "0.0000000012", "0.00001234", "0.1234", "1.5", "27123.45", "61234.5678", "0.000456", "123456.789",
+    "98765432109.123", "1.5E-7", "3500000000000000", "0.01", "7.77", "100", "0.00000001", "42.4242"
+};
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+template<typename T, typename Parse>
+void run(const std::string &name, const std::vector<std::string> &texts, Parse parse) {
+    std::vector<T> values(texts.size());
+    double sum = 0.0;
+
+    const auto parseTime = measure([&] {
+        for (std::size_t i = 0; i < texts.size(); ++i) {
+            values[i] = parse(texts[i]);
+        }
+    });
+
+    std::vector<T> copies(values.size());
+
+    const auto copyTime = measure([&] {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            copies[i] = values[i];
+        }
+    });
+
+    const auto convertTime = measure([&] {
+        for (const auto &value: copies) {
+            sum += value.template convert_to<double>();
+        }
+    });
+
+    const auto count = static_cast<double>(texts.size());
+    spdlog::info("{:<18} size: {:>3} B, parse: {:>7.1f} ns, copy: {:>6.1f} ns, to double: {:>6.1f} ns (sum {})",
+                 name, sizeof(T), parseTime / count, copyTime / count, convertTime / count, sum);
+}
+}
+
+int main() {
+    std::vector<std::string> texts;
+    texts.reserve(TEXTS.size() * 10000);
+
+    for (int i = 0; i < 10000; ++i) {
+        texts.insert(texts.end(), TEXTS.begin(), TEXTS.end());
+    }
+
+    /// FixedDecimal<8> cannot hold the largest values, the comparison uses the ones in its range
+    std::vector<std::string> fixedTexts;
+
+    for (const auto &text: texts) {
+        try {
+            FixedDecimal<8> value(text);
+            fixedTexts.push_back(text);
+        } catch (const std::runtime_error &) {
+        }
+    }
+
+    run<boost::multiprecision::cpp_dec_float_50>("cpp_dec_float_50", texts, [](const std::string &text) {
+        return boost::multiprecision::cpp_dec_float_50(text);
+    });
+
+    run<FixedDecimal<8>>("FixedDecimal<8>", fixedTexts, [](const std::string &text) {
+        return FixedDecimal<8>(text);
+    });
+
+    run<Decimal>("Decimal", texts, [](const std::string &text) {
+        return Decimal(text);
+    });
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+MEXC Frame Inflater Benchmark
+
+Compressed futures frames trade bytes on the wire for CPU on the receive path. For single ticker and depth frames
+and for batches of the replay, in gzip, zlib and raw deflate, measures the bytes a frame saves and what FrameInflater
+spends inflating it, next to zlib with a new inflate context per frame.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_frame_inflater.h"
+#include "ws_replay_frames.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace vk::mexc;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int FRAMES = 2000;
+constexpr int BATCH_SIZE = 50;
+
+struct Format {
+    const char *name;
+    /// deflateInit2 window bits selecting the gzip, zlib or raw deflate wrapper
+    int windowBits;
+};
+
+constexpr Format FORMATS[] = {{"gzip", 15 + 16}, {"zlib", 15}, {"raw deflate", -15}};
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+std::string compress(const std::string &data, const int windowBits) {
+    z_stream stream{};
+
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+
+    std::string retVal(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef *>(retVal.data());
+    stream.avail_out = static_cast<uInt>(retVal.size());
+    deflate(&stream, Z_FINISH);
+    retVal.resize(stream.total_out);
+    deflateEnd(&stream);
+    return retVal;
+}
+
+/// zlib inflate with its own context per frame, the output buffer is reused
+std::size_t zlibInflate(const std::string &payload, const int windowBits, std::string &output) {
+    z_stream stream{};
+
+    if (inflateInit2(&stream, windowBits) != Z_OK) {
+        throw std::runtime_error("inflateInit2 failed");
+    }
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(payload.data()));
+    stream.avail_in = static_cast<uInt>(payload.size());
+    stream.next_out = reinterpret_cast<Bytef *>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    if (inflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        inflateEnd(&stream);
+        throw std::runtime_error("inflate failed");
+    }
+
+    const auto retVal = stream.total_out;
+    inflateEnd(&stream);
+    return retVal;
+}
+
+void run(const std::string &name, const std::vector<std::string> &frames) {
+    std::size_t rawBytes = 0;
+
+    for (const auto &frame: frames) {
+        rawBytes += frame.size();
+    }
+
+    for (const auto &[formatName, windowBits]: FORMATS) {
+        std::vector<std::string> payloads;
+        std::size_t compressedBytes = 0;
+        std::size_t maxSize = 0;
+
+        for (const auto &frame: frames) {
+            payloads.push_back(compress(frame, windowBits));
+            compressedBytes += payloads.back().size();
+            maxSize = std::max(maxSize, frame.size());
+        }
+
+        FrameInflater inflater;
+        std::size_t inflated = 0;
+
+        const auto inflaterTime = measure([&] {
+            for (const auto &payload: payloads) {
+                inflated += inflater.inflate(payload).size();
+            }
+        });
+
+        std::string output(maxSize, '\0');
+        /// 15 + 32 detects the gzip or zlib header, raw deflate has none
+        const auto zlibWindowBits = windowBits < 0 ? windowBits : 15 + 32;
+
+        const auto zlibTime = measure([&] {
+            for (const auto &payload: payloads) {
+                inflated += zlibInflate(payload, zlibWindowBits, output);
+            }
+        });
+
+        if (inflated != rawBytes * ROUNDS * 2) {
+            throw std::runtime_error("Inflated size mismatch");
+        }
+
+        const auto count = static_cast<double>(frames.size());
+        /// Frames shorter than the wrapper and the block headers grow, nothing is saved for the CPU spent
+        const auto savedBytes = static_cast<double>(rawBytes) - static_cast<double>(compressedBytes);
+        const auto perSavedByte = savedBytes > 0 ? fmt::format("{:>6.2f} ns", inflaterTime / savedBytes) : "  none   ";
+        spdlog::info("{:<12} {:<11} {:>5.0f} B -> {:>5.0f} B ({:>5.1f}%), FrameInflater: {:>7.1f} ns per frame, "
+                     "{} per saved byte, {:>4.0f} MB/s, zlib new context: {:>7.1f} ns per frame",
+                     name, formatName, static_cast<double>(rawBytes) / count,
+                     static_cast<double>(compressedBytes) / count,
+                     100.0 * static_cast<double>(compressedBytes) / static_cast<double>(rawBytes),
+                     inflaterTime / count, perSavedByte, static_cast<double>(rawBytes) * 1000.0 / inflaterTime,
+                     zlibTime / count);
+    }
+}
+
+/// Replay frames joined into arrays of BATCH_SIZE, the size of a snapshot or of a batched push
+std::vector<std::string> batches(const int count) {
+    const auto frames = test::replayFrames(count * BATCH_SIZE);
+    std::vector<std::string> retVal;
+
+    for (int i = 0; i < count; ++i) {
+        std::string batch = "[";
+
+        for (int j = 0; j < BATCH_SIZE; ++j) {
+            batch += (j == 0 ? "" : ",") + frames[i * BATCH_SIZE + j];
+        }
+
+        retVal.push_back(batch + "]");
+    }
+
+    return retVal;
+}
+}
+
+int main() {
+    run("push.ticker", test::channelFrames(FRAMES, test::tickerFrame));
+    run("push.depth", test::channelFrames(FRAMES, test::depthFrame));
+    run("replay", test::replayFrames(FRAMES));
+    run("batch of 50", batches(FRAMES / BATCH_SIZE));
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+MEXC JSON Field Table Benchmark
+
+Compares the compile-time field tables which fill the futures models now with the chain of readValue lookups used
+before, on contract details and open positions. Both read from the same parsed document.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_models.h"
+#include "vk/mexc/mexc_json_scanner.h"
+#include "vk/utils/json_utils.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <string>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int CONTRACTS = 800;
+constexpr int POSITIONS = 200;
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+/// Decimals were read through double before the tables
+void readDecimal(const nlohmann::json &json, const std::string &key, Decimal &value) {
+    if (json.contains(key) && json[key].is_number()) {
+        value.assign(json[key].get<double>());
+    }
+}
+
+void readValueChain(const nlohmann::json &json, ContractDetail &detail) {
+    vk::readValue<std::string>(json, "symbol", detail.symbol);
+    vk::readValue<std::string>(json, "displayNameEn", detail.displayNameEn);
+    vk::readValue<std::string>(json, "baseCoin", detail.baseCoin);
+    vk::readValue<std::string>(json, "quoteCoin", detail.quoteCoin);
+    vk::readValue<std::string>(json, "settleCoin", detail.settleCoin);
+    vk::readValue<bool>(json, "apiAllowed", detail.apiAllowed);
+    vk::readValue<std::int32_t>(json, "automaticDelivery", detail.automaticDelivery);
+    vk::readValue<double>(json, "contractSize", detail.contractSize);
+    vk::readValue<std::int32_t>(json, "minVol", detail.minVol);
+    vk::readValue<std::int32_t>(json, "maxVol", detail.maxVol);
+    vk::readValue<std::int32_t>(json, "volUnit", detail.volUnit);
+    vk::readValue<double>(json, "priceUnit", detail.priceUnit);
+    vk::readValue<std::int32_t>(json, "pricePrecision", detail.pricePrecision);
+    vk::readValue<std::int32_t>(json, "volPrecision", detail.volPrecision);
+
+    if (json.contains("state") && json["state"].is_number()) {
+        detail.state = static_cast<ContractState>(json["state"].get<std::int32_t>());
+    }
+
+    if (json.contains("conceptPlate") && json["conceptPlate"].is_array()) {
+        for (const auto &item: json["conceptPlate"]) {
+            if (item.is_string()) {
+                detail.conceptPlate.push_back(item.get<std::string>());
+            }
+        }
+    }
+}
+
+void readValueChain(const nlohmann::json &json, OpenPosition &position) {
+    vk::readValue<std::int64_t>(json, "positionId", position.positionId);
+    vk::readValue<std::string>(json, "symbol", position.symbol);
+    vk::readValue<std::int32_t>(json, "positionType", position.positionType);
+    vk::readValue<std::int32_t>(json, "openType", position.openType);
+    vk::readValue<std::int32_t>(json, "state", position.state);
+    readDecimal(json, "holdVol", position.holdVol);
+    readDecimal(json, "frozenVol", position.frozenVol);
+    readDecimal(json, "holdAvgPrice", position.holdAvgPrice);
+    readDecimal(json, "openAvgPrice", position.openAvgPrice);
+    readDecimal(json, "liquidatePrice", position.liquidatePrice);
+    readDecimal(json, "oim", position.oim);
+    readDecimal(json, "im", position.im);
+    readDecimal(json, "holdFee", position.holdFee);
+    readDecimal(json, "realised", position.realised);
+    vk::readValue<std::int32_t>(json, "leverage", position.leverage);
+    vk::readValue<std::int64_t>(json, "createTime", position.createTime);
+    vk::readValue<std::int64_t>(json, "updateTime", position.updateTime);
+}
+
+std::string contractDetailsText() {
+    nlohmann::json data = nlohmann::json::array();
+
+    for (int i = 0; i < CONTRACTS; ++i) {
+        const auto base = "COIN" + std::to_string(i);
+        data.push_back({
+            {"symbol", base + "_USDT"}, {"displayNameEn", base + "_USDT PERPETUAL"}, {"displayName", base + "_USDT"},
+            {"positionOpenType", 3}, {"baseCoin", base}, {"quoteCoin", "USDT"}, {"settleCoin", "USDT"},
+            {"contractSize", 0.0001}, {"minLeverage", 1}, {"maxLeverage", 125}, {"priceScale", 1}, {"volScale", 0},
+            {"amountScale", 4}, {"priceUnit", 0.1}, {"volUnit", 1}, {"minVol", 1}, {"maxVol", 1250000},
+            {"bidLimitPriceRate", 0.1}, {"askLimitPriceRate", 0.1}, {"takerFeeRate", 0.0002}, {"makerFeeRate", 0},
+            {"maintenanceMarginRate", 0.004}, {"initialMarginRate", 0.008}, {"riskBaseVol", 150000},
+            {"riskIncrVol", 150000}, {"riskIncrMmr", 0.004}, {"riskIncrImr", 0.004}, {"riskLevelLimit", 5},
+            {"priceCoefficientVariation", 0.1}, {"indexOrigin", {"BINANCE", "GATEIO", "HUOBI", "MXC"}},
+            {"state", 0}, {"isNew", false}, {"isHot", true}, {"isHidden", false}, {"conceptPlate", {"mc-trade-zone-pow"}},
+            {"riskLimitType", "BY_VOLUME"}, {"maxNumOrders", {200, 50}}, {"marketOrderMaxLevel", 20},
+            {"marketOrderPriceLimitRate1", 0.2}, {"marketOrderPriceLimitRate2", 0.005}, {"triggerProtect", 0.1},
+            {"appraisal", 0}, {"showAppraisalCountdown", 0}, {"automaticDelivery", 0}, {"apiAllowed", false},
+            {"pricePrecision", 1}, {"volPrecision", 0}
+        });
+    }
+
+    return nlohmann::json{{"success", true}, {"code", 0}, {"data", data}}.dump();
+}
+
+std::string openPositionsText() {
+    nlohmann::json data = nlohmann::json::array();
+
+    for (int i = 0; i < POSITIONS; ++i) {
+        data.push_back({
+            {"positionId", 1394650 + i}, {"symbol", "COIN" + std::to_string(i) + "_USDT"}, {"positionType", 1 + i % 2},
+            {"openType", 1}, {"state", 1}, {"holdVol", 1 + i}, {"frozenVol", 0}, {"closeVol", 0},
+            {"holdAvgPrice", 27123.45 + i}, {"holdAvgPriceFullyScale", "27123.45"}, {"openAvgPrice", 27120.5},
+            {"openAvgPriceFullyScale", "27120.5"}, {"closeAvgPrice", 0}, {"liquidatePrice", 25012.3},
+            {"oim", 13.56172}, {"im", 13.56172}, {"holdFee", -0.000271}, {"realised", -0.0813}, {"leverage", 20},
+            {"createTime", 1700000000000 + i}, {"updateTime", 1700000100000 + i}, {"autoAddIm", false}
+        });
+    }
+
+    return nlohmann::json{{"success", true}, {"code", 0}, {"data", data}}.dump();
+}
+
+template<typename Model, typename Table, typename Chain>
+void run(const std::string &name, const nlohmann::json &data, Table table, Chain chain) {
+    std::vector<Model> models(data.size());
+
+    const auto tableTime = measure([&] {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            models[i] = {};
+            table(data[i], models[i]);
+        }
+    });
+
+    const auto chainTime = measure([&] {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            models[i] = {};
+            chain(data[i], models[i]);
+        }
+    });
+
+    const auto count = static_cast<double>(data.size());
+    spdlog::info("{:<16} objects: {:>4}, field table: {:>7.1f} ns, readValue chain: {:>7.1f} ns per object",
+                 name, data.size(), tableTime / count, chainTime / count);
+}
+}
+
+int main() {
+    const auto contracts = nlohmann::json::parse(contractDetailsText());
+    const auto positionsText = openPositionsText();
+    const auto positions = nlohmann::json::parse(positionsText);
+
+    run<ContractDetail>("ContractDetail", contracts["data"],
+                        [](const nlohmann::json &json, ContractDetail &detail) { detail.fromJson(json); },
+                        [](const nlohmann::json &json, ContractDetail &detail) { readValueChain(json, detail); });
+
+    run<OpenPosition>("OpenPosition", positions["data"],
+                      [](const nlohmann::json &json, OpenPosition &position) { position.fromJson(json); },
+                      [](const nlohmann::json &json, OpenPosition &position) { readValueChain(json, position); });
+
+    /// The positions decoded from the text with the scanner, including the parse which the two above do not pay
+    OpenPositions scanned;
+
+    const auto scanTime = measure([&] {
+        scanned = {};
+        JsonScanner scanner(positionsText);
+        scanned.fromJson(scanner);
+    });
+
+    spdlog::info("{:<16} objects: {:>4}, field table scan from text: {:>7.1f} ns per object",
+                 "OpenPosition", scanned.positions.size(), scanTime / POSITIONS);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+MEXC PMR Contract Details Benchmark
+
+Counts heap allocations and the time of one contract details response parsed into ContractDetails, into a reused
+PmrContractDetails from a DOM and into a reused PmrContractDetails straight from the text.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_models.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <spdlog/spdlog.h>
+#include <string>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int CONTRACTS = 800;
+
+std::atomic<std::size_t> g_allocations{0};
+
+/// Counts the blocks the arena takes from its upstream resource
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    std::size_t allocations{};
+
+private:
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::string contractDetailsText() {
+    nlohmann::json data = nlohmann::json::array();
+
+    for (int i = 0; i < CONTRACTS; ++i) {
+        const auto base = "COIN" + std::to_string(i);
+        data.push_back({
+            {"symbol", base + "_USDT"}, {"displayNameEn", base + "_USDT PERPETUAL"}, {"displayName", base + "_USDT"},
+            {"baseCoin", base}, {"quoteCoin", "USDT"}, {"settleCoin", "USDT"}, {"contractSize", 0.0001},
+            {"priceUnit", 0.1}, {"volUnit", 1}, {"minVol", 1}, {"maxVol", 1250000}, {"takerFeeRate", 0.0002},
+            {"indexOrigin", {"BINANCE", "GATEIO", "HUOBI", "MXC"}}, {"state", 0}, {"isNew", false},
+            {"conceptPlate", {"mc-trade-zone-pow", "mc-trade-zone-layer-one"}}, {"riskLimitType", "BY_VOLUME"},
+            {"automaticDelivery", 0}, {"apiAllowed", false}, {"pricePrecision", 1}, {"volPrecision", 0}
+        });
+    }
+
+    return nlohmann::json{{"success", true}, {"code", 0}, {"data", data}}.dump();
+}
+
+/// Heap allocations and nanoseconds of one call, averaged over ROUNDS after a warm-up call
+template<typename Function>
+std::pair<double, double> measure(Function &&function) {
+    function();
+    const auto allocations = g_allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    const auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return {static_cast<double>(g_allocations.load() - allocations) / ROUNDS, time / ROUNDS};
+}
+}
+
+void *operator new(const std::size_t size) {
+    ++g_allocations;
+
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    const auto text = contractDetailsText();
+
+    const auto [plainAllocations, plainTime] = measure([&] {
+        ContractDetails details;
+        details.fromJson(nlohmann::json::parse(text));
+    });
+
+    spdlog::info("{:<32} heap allocations: {:>7.0f}, time: {:>8.1f} us", "ContractDetails from DOM",
+                 plainAllocations, plainTime / 1000.0);
+
+    CountingResource domUpstream;
+    PmrContractDetails domDetails(256 * 1024, &domUpstream);
+
+    const auto [domAllocations, domTime] = measure([&] {
+        domDetails.fromJson(nlohmann::json::parse(text));
+    });
+
+    spdlog::info("{:<32} heap allocations: {:>7.0f}, time: {:>8.1f} us, upstream allocations: {}",
+                 "PmrContractDetails from DOM", domAllocations, domTime / 1000.0, domUpstream.allocations);
+
+    CountingResource scanUpstream;
+    PmrContractDetails scanDetails(256 * 1024, &scanUpstream);
+    std::size_t firstUpstream = 0;
+
+    const auto [scanAllocations, scanTime] = measure([&] {
+        JsonScanner scanner(text);
+        scanDetails.fromJson(scanner);
+
+        if (firstUpstream == 0) {
+            firstUpstream = scanUpstream.allocations;
+        }
+    });
+
+    spdlog::info("{:<32} heap allocations: {:>7.0f}, time: {:>8.1f} us, upstream allocations: {} in the first "
+                 "response, {} in the next {}, arena buffer: {} KiB", "PmrContractDetails from text", scanAllocations,
+                 scanTime / 1000.0, firstUpstream, scanUpstream.allocations - firstUpstream, ROUNDS,
+                 scanDetails.bufferSize() / 1024);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+MEXC Futures WebSocket Decode Benchmark
+
+Compares decoding push.ticker and push.kline frames through an nlohmann DOM, as the session did before, with
+EventFrame and the JsonScanner overloads of the typed events.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_event_models.h"
+#include "ws_replay_frames.h"
+#include <chrono>
+#include <spdlog/spdlog.h>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int ROUNDS = 20;
+constexpr int FRAMES = 10000;
+
+template<typename Function>
+double measure(Function &&function) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ROUNDS; ++i) {
+        function();
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+}
+
+template<typename T, typename Check>
+void run(const std::string &name, const std::vector<std::string> &frames, Check check) {
+    T model;
+    double sum = 0.0;
+
+    const auto domTime = measure([&] {
+        for (const auto &frame: frames) {
+            Event event;
+            event.fromJson(nlohmann::json::parse(frame));
+            model.fromJson(event.data);
+            sum += check(model);
+        }
+    });
+
+    const auto scanTime = measure([&] {
+        for (const auto &frame: frames) {
+            EventFrame eventFrame;
+            eventFrame.scan(frame);
+            JsonScanner scanner(eventFrame.data);
+            model.fromJson(scanner);
+            sum += check(model);
+        }
+    });
+
+    const auto count = static_cast<double>(frames.size());
+    spdlog::info("{:<12} DOM: {:>7.1f} ns, EventFrame + JsonScanner: {:>6.1f} ns per frame, {:.1f}x (check {})",
+                 name, domTime / count, scanTime / count, domTime / scanTime, sum);
+}
+}
+
+int main() {
+    run<EventTicker>("push.ticker", test::channelFrames(FRAMES, test::tickerFrame),
+                     [](const EventTicker &ticker) { return ticker.bid1; });
+    run<EventCandlestick>("push.kline", test::channelFrames(FRAMES, test::klineFrame),
+                          [](const EventCandlestick &candlestick) { return candlestick.close; });
+    return 0;
+}
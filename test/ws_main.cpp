@@ -3,6 +3,7 @@
 #include "vk/mexc/mexc.h"
 #include "vk/mexc/mexc_futures_ws_client.h"
 #include "vk/mexc/mexc_ws_stream_manager.h"
+#include "vk/mexc/mexc_spot_ws_stream_manager.h"
 #include "vk/utils/json_utils.h"
 
 using namespace std::chrono_literals;
@@ -87,6 +88,23 @@ void testWSManagerCandle() {
 	}
 }
 
+void testSpotWSManagerDeals() {
+	const auto wsManager = spot::WSStreamManager();
+	wsManager.subscribeDealsStream("BTCUSDT");
+	wsManager.setLoggerCallback(&logFunction);
+
+	while (true) {
+		{
+			if (const auto ret = wsManager.readEventDeals("BTCUSDT"); ret && !ret->deals.empty()) {
+				spdlog::info("BTC last deal price: {}", ret->deals.back().price);
+			} else {
+				spdlog::error("Error reading event");
+			}
+		}
+		std::this_thread::sleep_for(1000ms);
+	}
+}
+
 int main() {
 	testWSManagerCandle();
 	return getchar();
@@ -0,0 +1,164 @@
+/**
+MEXC Futures WebSocket Receive Allocation Benchmark
+
+Replays push frames through the receive path of the futures session and counts heap allocations per frame: the frame
+is read into a flat_buffer, scanned into an EventFrame and dispatched through a ChannelRegistry. The path used
+before, a multi_buffer copied into a fresh string and parsed into a DOM, is counted for comparison.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_channel_registry.h"
+#include "ws_replay_frames.h"
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/multi_buffer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <spdlog/spdlog.h>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+
+namespace {
+constexpr int FRAMES = 100000;
+constexpr int WARM_UP_FRAMES = 1000;
+
+std::atomic<std::size_t> g_allocations{0};
+
+/// Copies the frame into the buffer the way a websocket read does
+template<typename Buffer>
+void receive(Buffer &buffer, const std::string &frame) {
+    const auto target = buffer.prepare(frame.size());
+    boost::asio::buffer_copy(target, boost::asio::buffer(frame));
+    buffer.commit(frame.size());
+}
+
+/// Allocations of every frame after the warm-up
+template<typename Receive>
+void run(const std::string &name, const std::vector<std::string> &frames, Receive receiveFrame) {
+    std::size_t total = 0;
+    std::size_t maximum = 0;
+    std::size_t allocatingFrames = 0;
+
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const auto before = g_allocations.load();
+        receiveFrame(frames[i]);
+        const auto allocations = g_allocations.load() - before;
+
+        if (i >= WARM_UP_FRAMES) {
+            total += allocations;
+            maximum = std::max(maximum, allocations);
+            allocatingFrames += allocations > 0;
+        }
+    }
+
+    const auto count = frames.size() - WARM_UP_FRAMES;
+    spdlog::info("{:<44} allocations per frame: {:>6.2f}, max: {:>3}, frames which allocated: {} of {}",
+                 name, static_cast<double>(total) / static_cast<double>(count), maximum, allocatingFrames, count);
+}
+}
+
+void *operator new(const std::size_t size) {
+    ++g_allocations;
+
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    const auto frames = test::replayFrames(FRAMES);
+    std::size_t dispatched = 0;
+
+    /// Receive and dispatch only, the handlers do not decode
+    ChannelRegistry counting;
+
+    for (const auto *channel: {"push.ticker", "push.kline", "push.depth"}) {
+        counting.set(channel, [&dispatched](const EventFrame &) { ++dispatched; });
+    }
+
+    /// Handlers which decode into models kept across frames
+    EventTicker ticker;
+    EventCandlestick candlestick;
+    EventDepth depth;
+    ChannelRegistry reusing;
+    reusing.set("push.ticker", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        ticker.fromJson(scanner);
+    });
+    reusing.set("push.kline", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        candlestick.fromJson(scanner);
+    });
+    reusing.set("push.depth", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        depth.fromJson(scanner);
+    });
+
+    /// Handlers which decode into a new model per frame, as the ones WSClient registers for its typed callbacks
+    ChannelRegistry fresh;
+    fresh.set("push.ticker", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        EventTicker eventTicker;
+        eventTicker.fromJson(scanner);
+    });
+    fresh.set("push.kline", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        EventCandlestick eventCandlestick;
+        eventCandlestick.fromJson(scanner);
+    });
+    fresh.set("push.depth", [&](const EventFrame &eventFrame) {
+        JsonScanner scanner(eventFrame.data);
+        EventDepth eventDepth;
+        eventDepth.fromJson(scanner);
+    });
+
+    boost::beast::flat_buffer buffer;
+
+    const auto flatPath = [&](const ChannelRegistry &registry) {
+        return [&](const std::string &frame) {
+            receive(buffer, frame);
+            const auto data = buffer.cdata();
+            EventFrame eventFrame;
+
+            if (eventFrame.scan(std::string_view(static_cast<const char *>(data.data()), data.size()))) {
+                registry.dispatch(eventFrame);
+            }
+
+            buffer.consume(buffer.size());
+        };
+    };
+
+    run("flat_buffer + EventFrame + dispatch", frames, flatPath(counting));
+    run("... + decode into reused models", frames, flatPath(reusing));
+    run("... + decode into a new model per frame", frames, flatPath(fresh));
+
+    boost::beast::multi_buffer multiBuffer;
+
+    run("previous: multi_buffer + string copy + DOM", frames, [&](const std::string &frame) {
+        receive(multiBuffer, frame);
+        const auto text = boost::beast::buffers_to_string(multiBuffer.data());
+        multiBuffer.consume(multiBuffer.size());
+        Event event;
+        event.fromJson(nlohmann::json::parse(text));
+    });
+
+    spdlog::info("dispatched frames: {}", dispatched);
+    return 0;
+}
@@ -0,0 +1,303 @@
+/**
+MEXC Futures WebSocket Recovery Benchmark
+
+Measures how long the futures client takes to notice a dead connection and to get the stream back. A local TLS
+WebSocket server stands in for contract.mexc.com and pushes tickers, the client connects to it through a TCP relay.
+Each round the relay black-holes the open connections, as a dead NAT mapping or a silently dropped route does, so no
+error and no close frame reaches the client. The client has to detect the missing pongs, close the connection and
+reconnect with backoff.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#include "vk/mexc/mexc_futures_ws_client.h"
+#include "ws_replay_frames.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+using namespace vk::mexc;
+using namespace vk::mexc::futures;
+using boost::asio::ip::tcp;
+
+namespace {
+constexpr int ROUNDS = 5;
+constexpr auto PUSH_INTERVAL = std::chrono::milliseconds(10);
+
+const ReconnectSettings RECONNECT_SETTINGS{
+    std::chrono::milliseconds(50), std::chrono::milliseconds(1000), 2.0, std::chrono::milliseconds(100), 2
+};
+
+/// Self-signed certificate of the stand-in, the client does not verify the peer
+void useSelfSignedCertificate(boost::asio::ssl::context &ctx) {
+    EVP_PKEY *key = EVP_RSA_gen(2048);
+    X509 *certificate = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), 3600);
+    X509_set_pubkey(certificate, key);
+    auto *name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"), -1, -1,
+                               0);
+    X509_set_issuer_name(certificate, name);
+    X509_sign(certificate, key, EVP_sha256());
+    SSL_CTX_use_certificate(ctx.native_handle(), certificate);
+    SSL_CTX_use_PrivateKey(ctx.native_handle(), key);
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+}
+
+/// Answers the subscriptions and pushes a ticker every PUSH_INTERVAL, pings are answered while a read is pending
+class ServerSession : public std::enable_shared_from_this<ServerSession> {
+    boost::beast::websocket::stream<boost::asio::ssl::stream<tcp::socket>> m_ws;
+    boost::beast::flat_buffer m_buffer;
+    boost::asio::steady_timer m_timer;
+    std::deque<std::string> m_writeQueue;
+    int m_frame{};
+
+    void read() {
+        m_ws.async_read(m_buffer, [self = shared_from_this()](const boost::beast::error_code &ec, std::size_t) {
+            if (ec) {
+                self->m_timer.cancel();
+                return;
+            }
+
+            const auto request = nlohmann::json::parse(boost::beast::buffers_to_string(self->m_buffer.data()));
+            self->m_buffer.consume(self->m_buffer.size());
+            self->write(fmt::format(R"({{"channel":"rs.{}","data":"success","ts":{}}})",
+                                    request.value("method", std::string()), 1700000000000));
+            self->read();
+        });
+    }
+
+    void push() {
+        m_timer.expires_after(PUSH_INTERVAL);
+        m_timer.async_wait([self = shared_from_this()](const boost::beast::error_code &ec) {
+            if (!ec) {
+                self->write(test::tickerFrame(self->m_frame++));
+                self->push();
+            }
+        });
+    }
+
+    void write(std::string message) {
+        m_writeQueue.push_back(std::move(message));
+
+        if (m_writeQueue.size() == 1) {
+            writeNext();
+        }
+    }
+
+    void writeNext() {
+        m_ws.async_write(boost::asio::buffer(m_writeQueue.front()),
+                         [self = shared_from_this()](const boost::beast::error_code &ec, std::size_t) {
+                             if (ec) {
+                                 return;
+                             }
+
+                             self->m_writeQueue.pop_front();
+
+                             if (!self->m_writeQueue.empty()) {
+                                 self->writeNext();
+                             }
+                         });
+    }
+
+public:
+    ServerSession(tcp::socket socket, boost::asio::ssl::context &ctx) : m_ws(std::move(socket), ctx),
+                                                                          m_timer(m_ws.get_executor()) {
+    }
+
+    void run() {
+        m_ws.next_layer().async_handshake(boost::asio::ssl::stream_base::server,
+                                          [self = shared_from_this()](const boost::beast::error_code &ec) {
+                                              if (ec) {
+                                                  return;
+                                              }
+
+                                              self->m_ws.async_accept([self](const boost::beast::error_code &e) {
+                                                  if (!e) {
+                                                      self->read();
+                                                      self->push();
+                                                  }
+                                              });
+                                          });
+    }
+};
+
+/// Forwards the bytes of one client connection to the server until the relay black-holes it
+struct Pipe : std::enable_shared_from_this<Pipe> {
+    tcp::socket client;
+    tcp::socket server;
+    int generation;
+    const std::atomic<int> &relayGeneration;
+    std::array<char, 16384> up{};
+    std::array<char, 16384> down{};
+
+    Pipe(tcp::socket clientSocket, boost::asio::io_context &ioContext, const int generation,
+         const std::atomic<int> &relayGeneration) : client(std::move(clientSocket)), server(ioContext),
+                                                    generation(generation), relayGeneration(relayGeneration) {
+    }
+
+    /// Read from one side and write to the other, a black-holed pipe keeps the sockets open and forwards nothing
+    void pump(tcp::socket &from, tcp::socket &to, std::array<char, 16384> &data) {
+        from.async_read_some(boost::asio::buffer(data), [self = shared_from_this(), &from, &to, &data](
+                             const boost::beast::error_code &ec, const std::size_t size) {
+                                 if (ec || self->generation != self->relayGeneration) {
+                                     return;
+                                 }
+
+                                 boost::asio::async_write(to, boost::asio::buffer(data, size),
+                                                          [self, &from, &to, &data](const boost::beast::error_code &e,
+                                                                                    std::size_t) {
+                                                              if (!e) {
+                                                                  self->pump(from, to, data);
+                                                              }
+                                                          });
+                             });
+    }
+};
+
+/// Server and relay on one IO thread
+class StandIn {
+    boost::asio::io_context m_ioContext;
+    boost::asio::ssl::context m_ctx{boost::asio::ssl::context::tls_server};
+    tcp::acceptor m_serverAcceptor{m_ioContext, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0)};
+    tcp::acceptor m_relayAcceptor{m_ioContext, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0)};
+    std::atomic<int> m_generation{0};
+    /// Black-holed pipes, kept so their sockets stay open
+    std::vector<std::shared_ptr<Pipe>> m_pipes;
+    std::thread m_thread;
+
+    void acceptServer() {
+        m_serverAcceptor.async_accept([this](const boost::beast::error_code &ec, tcp::socket socket) {
+            if (!ec) {
+                std::make_shared<ServerSession>(std::move(socket), m_ctx)->run();
+                acceptServer();
+            }
+        });
+    }
+
+    void acceptRelay() {
+        m_relayAcceptor.async_accept([this](const boost::beast::error_code &ec, tcp::socket socket) {
+            if (ec) {
+                return;
+            }
+
+            auto pipe = std::make_shared<Pipe>(std::move(socket), m_ioContext, m_generation, m_generation);
+            m_pipes.push_back(pipe);
+            pipe->server.async_connect(m_serverAcceptor.local_endpoint(),
+                                       [pipe](const boost::beast::error_code &e) {
+                                           if (!e) {
+                                               pipe->pump(pipe->client, pipe->server, pipe->up);
+                                               pipe->pump(pipe->server, pipe->client, pipe->down);
+                                           }
+                                       });
+            acceptRelay();
+        });
+    }
+
+public:
+    StandIn() {
+        useSelfSignedCertificate(m_ctx);
+        acceptServer();
+        acceptRelay();
+        m_thread = std::thread([this] { m_ioContext.run(); });
+    }
+
+    ~StandIn() {
+        m_ioContext.stop();
+        m_thread.join();
+    }
+
+    [[nodiscard]] std::string port() const {
+        return std::to_string(m_relayAcceptor.local_endpoint().port());
+    }
+
+    /// The open connections stop forwarding in both directions, new ones are forwarded
+    void blackHole() {
+        ++m_generation;
+    }
+};
+
+double milliseconds(const std::chrono::system_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+}
+
+int main() {
+    StandIn standIn;
+    std::mutex locker;
+    std::condition_variable condition;
+    std::size_t tickers = 0;
+    std::optional<StreamGap> streamGap;
+    std::optional<std::chrono::system_clock::time_point> detected;
+
+    WSClient client;
+    client.setEndpoint("127.0.0.1", standIn.port());
+    client.setReconnectSettings(RECONNECT_SETTINGS);
+    client.setLoggerCallback([&](const vk::LogSeverity, const std::string &message) {
+        if (message.find("no pong") != std::string::npos) {
+            std::lock_guard lk(locker);
+            detected = std::chrono::system_clock::now();
+        }
+    });
+    client.setEventTickerCallback([&](const EventTicker &) {
+        std::lock_guard lk(locker);
+        ++tickers;
+        condition.notify_all();
+    });
+    client.setStreamGapCallback([&](const StreamGap &gap) {
+        std::lock_guard lk(locker);
+        streamGap = gap;
+        condition.notify_all();
+    });
+    client.subscribe(nlohmann::json{{"method", "sub.ticker"}, {"param", {{"symbol", "BTC_USDT"}}}});
+
+    spdlog::info("ping interval {} ms, max missed pongs {}, initial backoff {} ms",
+                 RECONNECT_SETTINGS.pingInterval.count(), RECONNECT_SETTINGS.maxMissedPongs,
+                 RECONNECT_SETTINGS.initialBackoff.count());
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::unique_lock lk(locker);
+
+        if (!condition.wait_for(lk, std::chrono::seconds(10), [&] { return tickers > 0; })) {
+            spdlog::error("round {}: no tickers received", round);
+            return 1;
+        }
+
+        streamGap.reset();
+        detected.reset();
+        const auto start = std::chrono::system_clock::now();
+        standIn.blackHole();
+
+        if (!condition.wait_for(lk, std::chrono::seconds(10), [&] { return streamGap.has_value(); })) {
+            spdlog::error("round {}: the stream did not recover", round);
+            return 1;
+        }
+
+        spdlog::info("round {}: dead connection detected after {:>6.1f} ms, stream recovered after {:>6.1f} ms, "
+                     "gap {:>6.1f} ms, attempts {}", round, detected ? milliseconds(*detected - start) : -1.0,
+                     milliseconds(streamGap->to - start), milliseconds(streamGap->to - streamGap->from),
+                     streamGap->attempts);
+        tickers = 0;
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+MEXC Futures WebSocket Replay Frames
+
+Frames of the futures push channels for the replay benchmarks. The templates have the members and number formats of
+the frames sent by wss://contract.mexc.com/edge, the replay varies their prices, volumes and timestamps
+deterministically.
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Vitezslav Kot <vitezslav.kot@gmail.com>.
+*/
+
+#ifndef INCLUDE_VK_MEXC_TEST_WS_REPLAY_FRAMES_H
+#define INCLUDE_VK_MEXC_TEST_WS_REPLAY_FRAMES_H
+
+#include <cstdint>
+#include <fmt/format.h>
+#include <string>
+#include <vector>
+
+namespace vk::mexc::test {
+inline std::string tickerFrame(const int i) {
+    const auto ts = 1700000000123 + static_cast<std::int64_t>(i) * 100;
+    return fmt::format(R"({{"channel":"push.ticker","data":{{"ask1":{:.1f},"bid1":{:.1f},"contractId":10,)"
+                       R"("fairPrice":{:.1f},"fundingRate":0.0001,"high24Price":27500,"holdVol":{},)"
+                       R"("indexPrice":{:.1f},"lastPrice":{:.1f},"lower24Price":26800,"maxBidPrice":29836,)"
+                       R"("minAskPrice":24411,"riseFallRate":0.0123,"riseFallValue":330.5,"symbol":"BTC_USDT",)"
+                       R"("timestamp":{},"volume24":{},"zone":"UTC+8"}},"symbol":"BTC_USDT","ts":{}}})",
+                       27123.5 + i % 50 * 0.1, 27123.4 + i % 50 * 0.1, 27123.6 + i % 40 * 0.1, 4211123 + i,
+                       27124.1 + i % 30 * 0.1, 27123.5 + i % 50 * 0.1, ts, 98765432 + i * 7, ts);
+}
+
+inline std::string klineFrame(const int i) {
+    const auto start = 1700000040 + static_cast<std::int64_t>(i / 60) * 60;
+    return fmt::format(R"({{"channel":"push.kline","data":{{"a":{:.2f},"c":{:.1f},"h":27150,"interval":"Min1",)"
+                       R"("l":27100.5,"o":27110,"q":{},"rc":{:.1f},"rh":27150,"rl":27100.5,"ro":27110,)"
+                       R"("symbol":"BTC_USDT","t":{}}},"symbol":"BTC_USDT","ts":{}}})",
+                       233740269.15 + i * 27.5, 27100.5 + i % 495 * 0.1, 86324 + i, 27100.5 + i % 495 * 0.1, start,
+                       start * 1000 + 123 + i % 60);
+}
+
+inline std::string depthFrame(const int i) {
+    return fmt::format(R"({{"channel":"push.depth","data":{{"asks":[[{:.1f},{},1]],"bids":[[{:.1f},{},2]],)"
+                       R"("version":{}}},"symbol":"BTC_USDT","ts":{}}})",
+                       27124.0 + i % 20 * 0.1, 1200 + i % 300, 27123.4 - i % 20 * 0.1, 5 + i % 90,
+                       3021456789LL + i, 1700000000200 + static_cast<std::int64_t>(i) * 100);
+}
+
+/**
+ * Interleaved replay in the proportions of a BTC_USDT subscription, about 5 depth updates per ticker and kline
+ * @param count number of frames
+ */
+inline std::vector<std::string> replayFrames(const int count) {
+    std::vector<std::string> retVal;
+    retVal.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        switch (i % 7) {
+        case 0:
+            retVal.push_back(tickerFrame(i));
+            break;
+        case 1:
+            retVal.push_back(klineFrame(i));
+            break;
+        default:
+            retVal.push_back(depthFrame(i));
+        }
+    }
+
+    return retVal;
+}
+
+/// Frames of one channel only
+template<typename Make>
+std::vector<std::string> channelFrames(const int count, Make make) {
+    std::vector<std::string> retVal;
+    retVal.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        retVal.push_back(make(i));
+    }
+
+    return retVal;
+}
+}
+
+#endif // INCLUDE_VK_MEXC_TEST_WS_REPLAY_FRAMES_H